@@ -0,0 +1,381 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+
+// 存储个人信息结构体
+struct PersonInfo {
+    std::string name;
+    std::string gender;
+    std::string birthdate;
+    std::string address;
+    std::string phone;
+
+    PersonInfo(const std::string& n, const std::string& g, const std::string& b, const std::string& a, const std::string& p)
+        : name(n), gender(g), birthdate(b), address(a), phone(p) {}
+};
+
+// 哈希表运行统计，dump() 输出单行 JSON 便于采集
+struct HashTableStats {
+    size_t num_elements = 0;
+    size_t bucket_count = 0;
+    double load_factor = 0;
+    std::vector<size_t> chain_length_histogram; // [i] 为链长等于 i 的桶数，最后一格包含更长的
+    size_t successful_finds = 0;
+    size_t successful_probes = 0; // 查找时比较过的节点数
+    size_t max_successful_probes = 0;
+    size_t unsuccessful_finds = 0;
+    size_t unsuccessful_probes = 0;
+    size_t max_unsuccessful_probes = 0;
+    size_t split_count = 0;         // 线性哈希分裂次数
+    size_t rehash_count = 0;        // 整体翻倍次数
+    double rehash_seconds = 0;      // 所有整体翻倍累计耗时
+    double last_rehash_seconds = 0; // 最近一次整体翻倍耗时
+    size_t bytes_used = 0;
+
+    double averageSuccessfulProbes() const {
+        return successful_finds ? (double)successful_probes / successful_finds : 0;
+    }
+
+    double averageUnsuccessfulProbes() const {
+        return unsuccessful_finds ? (double)unsuccessful_probes / unsuccessful_finds : 0;
+    }
+
+    void dump(std::ostream& out) const {
+        out << "{\"num_elements\":" << num_elements
+            << ",\"bucket_count\":" << bucket_count
+            << ",\"load_factor\":" << load_factor
+            << ",\"chain_length_histogram\":[";
+        for (size_t i = 0; i < chain_length_histogram.size(); ++i) {
+            out << (i ? "," : "") << chain_length_histogram[i];
+        }
+        out << "],\"successful_finds\":" << successful_finds
+            << ",\"avg_successful_probes\":" << averageSuccessfulProbes()
+            << ",\"max_successful_probes\":" << max_successful_probes
+            << ",\"unsuccessful_finds\":" << unsuccessful_finds
+            << ",\"avg_unsuccessful_probes\":" << averageUnsuccessfulProbes()
+            << ",\"max_unsuccessful_probes\":" << max_unsuccessful_probes
+            << ",\"split_count\":" << split_count
+            << ",\"rehash_count\":" << rehash_count
+            << ",\"rehash_seconds\":" << rehash_seconds
+            << ",\"last_rehash_seconds\":" << last_rehash_seconds
+            << ",\"bytes_used\":" << bytes_used << "}" << std::endl;
+    }
+};
+
+// 扩容方式
+enum class GrowthMode {
+    FullRehash, // 负载因子超限时一次性把所有桶翻倍重排
+    Linear      // 线性哈希：每次插入最多分裂一个桶，扩容开销分摊到每次插入
+};
+
+// 哈希表类
+class ExternalHashTable {
+private:
+    typedef std::list<std::pair<std::string, PersonInfo>> Bucket;
+
+    // 桶按固定大小分段存放，扩容时只追加新段，已有桶不会被搬动
+    static const size_t kSegmentShift = 10;
+    static const size_t kSegmentSize = size_t(1) << kSegmentShift;
+    static const size_t kInitialBuckets = 1024; // 初始桶数，必须是 2 的幂
+
+    std::vector<std::unique_ptr<Bucket[]>> segments;
+    GrowthMode mode;
+    size_t level;         // 当前轮次，基准桶数为 kInitialBuckets << level
+    size_t next_split;    // 线性哈希中下一个待分裂的桶
+    size_t bucket_count;  // 当前桶数
+    size_t num_elements;  // 当前已存储的元素个数
+    const double load_factor_threshold = 1.0; // 负载因子阈值
+    static const size_t kHistogramBins = 16; // 链长直方图的格数
+    HashTableStats counters; // 查找与扩容计数，只做整数累加，常开开销很小
+
+public:
+    ExternalHashTable(GrowthMode growth = GrowthMode::Linear)
+        : mode(growth), level(0), next_split(0), bucket_count(0), num_elements(0) {
+        addBuckets(kInitialBuckets);
+    }
+
+    // 从CSV文件加载数据
+    // presize 为 true 时先按文件大小估算行数并一次性预留桶数，加载过程中不再扩容
+    void loadFromFile(const std::string& filename, bool presize = true) {
+        std::ifstream infile(filename);  // 直接读取GBK编码的文件
+
+        // 判断文件是否成功打开
+        if (!infile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+
+        std::string line;
+        std::getline(infile, line);  // 跳过文件表头
+
+        if (presize) {
+            reserve(num_elements + estimateRowCount(infile));
+        }
+
+        // 读取每一行数据
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string id, name, gender, birthdate, address, phone;
+
+            // 按逗号分隔每一行
+            std::getline(ss, id, ',');
+            std::getline(ss, name, ',');
+            std::getline(ss, gender, ',');
+            std::getline(ss, birthdate, ',');
+            std::getline(ss, address, ',');
+            std::getline(ss, phone, ',');
+
+            // 将数据插入哈希表
+            insert(id, name, gender, birthdate, address, phone);
+        }
+    }
+
+    // 插入数据到哈希表
+    void insert(const std::string& id, const std::string& name, const std::string& gender,
+        const std::string& birthdate, const std::string& address, const std::string& phone) {
+        bucketAt(bucketIndex(hashFunction(id))).emplace_back(id, PersonInfo(name, gender, birthdate, address, phone));
+        ++num_elements;
+
+        if ((double)num_elements / bucket_count > load_factor_threshold) {
+            if (mode == GrowthMode::Linear) {
+                splitNextBucket();
+            }
+            else {
+                rehash();
+            }
+        }
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) {
+        size_t probes = 0;
+        for (const auto& kv : bucketAt(bucketIndex(hashFunction(id)))) {
+            ++probes;
+            if (kv.first == id) {
+                recordFind(true, probes);
+                return kv.second;
+            }
+        }
+        recordFind(false, probes);
+        return PersonInfo("", "", "", "", "");
+    }
+
+    // 将哈希表保存到文件
+    void saveToFile(const std::string& filename) {
+        std::ofstream outfile(filename);
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        // 写入表头
+        outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+
+        // 遍历哈希表中的每一项
+        for (size_t i = 0; i < bucket_count; ++i) {
+            for (const auto& kv : bucketAt(i)) {
+                // 将身份证号和对应的个人信息保存到文件
+                outfile << kv.first << ","
+                    << kv.second.name << ","
+                    << kv.second.gender << ","
+                    << kv.second.birthdate << ","
+                    << kv.second.address << ","
+                    << kv.second.phone << "\n";
+            }
+        }
+
+        outfile.close();
+        std::cout << "Data saved to file: " << filename << std::endl;
+    }
+
+    size_t size() const { return num_elements; }
+    size_t bucketCount() const { return bucket_count; }
+
+    // 预留足够的桶，使存入 n 条数据前不再触发扩容或分裂
+    void reserve(size_t n) {
+        size_t new_level = level;
+        while ((double)(kInitialBuckets << new_level) * load_factor_threshold < n) {
+            ++new_level;
+        }
+        if ((kInitialBuckets << new_level) > bucket_count) {
+            rehash(new_level);
+        }
+    }
+
+    // 生成当前统计快照；直方图与内存占用需要遍历整张表，按需调用
+    HashTableStats stats() const {
+        HashTableStats snapshot = counters;
+        snapshot.num_elements = num_elements;
+        snapshot.bucket_count = bucket_count;
+        snapshot.load_factor = (double)num_elements / bucket_count;
+        snapshot.chain_length_histogram.assign(kHistogramBins, 0);
+        snapshot.bytes_used = segments.capacity() * sizeof(segments[0])
+            + segments.size() * kSegmentSize * sizeof(Bucket);
+
+        // 链表节点：两个指针加上数据本身
+        const size_t node_bytes = 2 * sizeof(void*) + sizeof(std::pair<std::string, PersonInfo>);
+        for (size_t i = 0; i < bucket_count; ++i) {
+            const Bucket& bucket = bucketAt(i);
+            size_t length = 0;
+            for (const auto& kv : bucket) {
+                ++length;
+                snapshot.bytes_used += node_bytes + heapBytes(kv.first) + heapBytes(kv.second.name)
+                    + heapBytes(kv.second.gender) + heapBytes(kv.second.birthdate)
+                    + heapBytes(kv.second.address) + heapBytes(kv.second.phone);
+            }
+            ++snapshot.chain_length_histogram[length < kHistogramBins ? length : kHistogramBins - 1];
+        }
+        return snapshot;
+    }
+
+    // 清零查找计数（扩容计数保留）
+    void resetFindStats() {
+        counters.successful_finds = counters.successful_probes = counters.max_successful_probes = 0;
+        counters.unsuccessful_finds = counters.unsuccessful_probes = counters.max_unsuccessful_probes = 0;
+    }
+
+private:
+    // 简单的哈希函数，返回完整哈希值，由 bucketIndex 决定落在哪个桶
+    unsigned long hashFunction(const std::string& key) const {
+        unsigned long hashValue = 0;
+        for (char c : key) {
+            hashValue = hashValue * 31 + c;
+        }
+        return hashValue;
+    }
+
+    // 线性哈希寻址：先按本轮桶数取模，已分裂过的桶再按下一轮桶数取模
+    size_t bucketIndex(unsigned long hashValue) const {
+        size_t round_size = kInitialBuckets << level;
+        size_t index = hashValue & (round_size - 1);
+        if (index < next_split) {
+            index = hashValue & (2 * round_size - 1);
+        }
+        return index;
+    }
+
+    void recordFind(bool found, size_t probes) {
+        if (found) {
+            ++counters.successful_finds;
+            counters.successful_probes += probes;
+            counters.max_successful_probes = std::max(counters.max_successful_probes, probes);
+        }
+        else {
+            ++counters.unsuccessful_finds;
+            counters.unsuccessful_probes += probes;
+            counters.max_unsuccessful_probes = std::max(counters.max_unsuccessful_probes, probes);
+        }
+    }
+
+    // 字符串在堆上额外占用的字节数（短字符串存放在对象内部时为 0）
+    static size_t heapBytes(const std::string& s) {
+        const char* data = s.data();
+        const char* self = reinterpret_cast<const char*>(&s);
+        return (data >= self && data < self + sizeof(s)) ? 0 : s.capacity() + 1;
+    }
+
+    Bucket& bucketAt(size_t index) {
+        return segments[index >> kSegmentShift][index & (kSegmentSize - 1)];
+    }
+
+    const Bucket& bucketAt(size_t index) const {
+        return segments[index >> kSegmentShift][index & (kSegmentSize - 1)];
+    }
+
+    // 追加 count 个空桶（count 为 kSegmentSize 的整数倍）
+    void addBuckets(size_t count) {
+        for (size_t i = 0; i < count; i += kSegmentSize) {
+            segments.emplace_back(new Bucket[kSegmentSize]);
+        }
+        bucket_count += count;
+    }
+
+    // 分裂 next_split 指向的桶，只搬动这一个桶里的节点
+    void splitNextBucket() {
+        size_t round_size = kInitialBuckets << level;
+        if ((bucket_count >> kSegmentShift) == segments.size()) {
+            segments.emplace_back(new Bucket[kSegmentSize]); // 新桶只追加在末尾，按段申请
+        }
+        ++bucket_count;
+
+        Bucket& old_bucket = bucketAt(next_split);
+        Bucket& new_bucket = bucketAt(next_split + round_size);
+        for (auto it = old_bucket.begin(); it != old_bucket.end();) {
+            auto current = it++;
+            if (hashFunction(current->first) & round_size) {
+                new_bucket.splice(new_bucket.end(), old_bucket, current); // 只改链表指针，不复制数据
+            }
+        }
+
+        ++counters.split_count;
+        if (++next_split == round_size) {
+            ++level;
+            next_split = 0;
+        }
+    }
+
+    // 用文件剩余字节数除以前若干行的平均长度估算剩余行数，读完样本后回到原位置
+    static size_t estimateRowCount(std::ifstream& infile) {
+        const size_t kSampleLines = 1000;
+        std::streampos data_start = infile.tellg();
+        infile.seekg(0, std::ios::end);
+        std::streamoff remaining = infile.tellg() - data_start;
+        infile.seekg(data_start);
+
+        std::string line;
+        size_t sampled_lines = 0, sampled_bytes = 0;
+        while (sampled_lines < kSampleLines && std::getline(infile, line)) {
+            ++sampled_lines;
+            sampled_bytes += line.size() + 1;
+        }
+        infile.clear();
+        infile.seekg(data_start);
+
+        if (sampled_bytes == 0) {
+            return 0;
+        }
+        // 多估 5%，避免样本行偏长时最后还要扩容一次
+        return (size_t)((double)remaining / sampled_bytes * sampled_lines * 1.05);
+    }
+
+    // 一次性把所有节点重排到 kInitialBuckets << new_level 个桶中，默认翻倍
+    void rehash() {
+        rehash(level + 1);
+    }
+
+    void rehash(size_t new_level) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<Bucket[]>> old_segments;
+        old_segments.swap(segments);
+        bucket_count = 0;
+        addBuckets(kInitialBuckets << new_level);
+        level = new_level;
+        next_split = 0;
+
+        for (auto& segment : old_segments) {
+            for (size_t i = 0; i < kSegmentSize; ++i) {
+                Bucket& bucket = segment[i];
+                while (!bucket.empty()) {
+                    Bucket& target = bucketAt(bucketIndex(hashFunction(bucket.front().first)));
+                    target.splice(target.end(), bucket, bucket.begin());
+                }
+            }
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        ++counters.rehash_count;
+        counters.rehash_seconds += elapsed.count();
+        counters.last_rehash_seconds = elapsed.count();
+
+        std::cout << "Rehashed hash table to size: " << bucket_count << std::endl;
+    }
+};
@@ -0,0 +1,134 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include "ExternalHashTable.h"
+
+using namespace std;
+
+// 生成随机身份证号（17 位随机数字 + 校验码，与 Data.py 相同）
+vector<string> generateIds(size_t count, unsigned seed) {
+    static const int weight[17] = { 7, 9, 10, 5, 8, 4, 2, 1, 6, 3, 7, 9, 10, 5, 8, 4, 2 };
+    static const char check_code_map[] = "10X98765432";
+
+    mt19937_64 rng(seed);
+    vector<string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        string id(18, '0');
+        int total = 0;
+        id[0] = char('1' + rng() % 9);
+        for (int j = 1; j < 17; ++j) {
+            id[j] = char('0' + rng() % 10);
+        }
+        for (int j = 0; j < 17; ++j) {
+            total += (id[j] - '0') * weight[j];
+        }
+        id[17] = check_code_map[total % 11];
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+// 返回已排序样本的 p 分位数
+long long percentile(const vector<long long>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = (size_t)(p * (sorted.size() - 1));
+    return sorted[index];
+}
+
+// 逐条插入并记录每次插入的耗时，按数据量区间（1k-10k, 10k-100k, ...）输出分位数
+void benchInsertLatency(GrowthMode mode, const vector<string>& ids) {
+    ExternalHashTable hashTable(mode);
+    vector<long long> latencies(ids.size());
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto insert_start = chrono::steady_clock::now();
+        hashTable.insert(ids[i], "张三", "Male", "2000-01-01", "广州", "13800000000");
+        auto insert_end = chrono::steady_clock::now();
+        latencies[i] = chrono::duration_cast<chrono::nanoseconds>(insert_end - insert_start).count();
+    }
+    chrono::duration<double> total = chrono::steady_clock::now() - start;
+
+    cout << (mode == GrowthMode::Linear ? "[linear]" : "[full-rehash]")
+        << " inserted " << ids.size() << " rows in " << total.count() << " s, "
+        << hashTable.bucketCount() << " buckets" << endl;
+    cout << "  range                p50(ns)    p99(ns)  p99.9(ns)      max(ns)" << endl;
+
+    for (size_t low = 1000; low < ids.size(); low *= 10) {
+        size_t high = min(low * 10, ids.size());
+        vector<long long> window(latencies.begin() + low, latencies.begin() + high);
+        sort(window.begin(), window.end());
+        printf("  %9zu-%-9zu %9lld %10lld %10lld %12lld\n", low, high,
+            percentile(window, 0.5), percentile(window, 0.99),
+            percentile(window, 0.999), window.back());
+    }
+
+    vector<long long> all(latencies.begin(), latencies.end());
+    sort(all.begin(), all.end());
+    printf("  %-19s %9lld %10lld %10lld %12lld\n", "all",
+        percentile(all, 0.5), percentile(all, 0.99), percentile(all, 0.999), all.back());
+
+    // 校验：随机抽查一部分数据能否查到
+    for (size_t i = 0; i < ids.size(); i += 997) {
+        if (hashTable.find(ids[i]).name.empty()) {
+            cerr << "Lookup failed for " << ids[i] << endl;
+        }
+    }
+}
+
+// 生成 CSV 测试文件
+void writeCsv(const string& filename, const vector<string>& ids) {
+    ofstream outfile(filename);
+    outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+    for (const string& id : ids) {
+        outfile << id << ",张三,Male,2000-01-01,广州市天河区五山路381号,13800000000\n";
+    }
+}
+
+// 分别在不预留与按文件大小预留容量的情况下加载同一个 CSV 文件
+void benchLoad(size_t count) {
+    const string filename = "bench_person_info.csv";
+    writeCsv(filename, generateIds(count, 1));
+
+    for (bool presize : { false, true }) {
+        ExternalHashTable hashTable(GrowthMode::Linear);
+        auto start = chrono::steady_clock::now();
+        hashTable.loadFromFile(filename, presize);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        HashTableStats stats = hashTable.stats();
+        printf("[%s] loaded %zu rows in %.3f s, rehashes %zu (%.3f s), splits %zu\n",
+            presize ? "presized" : "no-presize", hashTable.size(), elapsed.count(),
+            stats.rehash_count, stats.rehash_seconds, stats.split_count);
+    }
+
+    remove(filename.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "latency";
+    size_t count = argc > 2 ? strtoull(argv[2], nullptr, 10) : 10000000;
+
+    if (mode == "latency") {
+        vector<string> ids = generateIds(count, 20241018);
+        benchInsertLatency(GrowthMode::FullRehash, ids);
+        benchInsertLatency(GrowthMode::Linear, ids);
+    }
+    else if (mode == "load") {
+        benchLoad(count);
+    }
+    else {
+        cerr << "Unknown benchmark: " << mode << endl;
+        return 1;
+    }
+
+    return 0;
+}
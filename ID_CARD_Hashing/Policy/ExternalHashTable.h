@@ -0,0 +1,264 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// 策略模板化的开放寻址哈希表：键类型、哈希函数、探测序列与扩容规则都在编译期确定，
+// 组合出的每个实例都是单独特化的代码，没有虚函数调用。
+// 槽位数始终为 2 的幂，取下标用掩码代替取模。
+namespace hashing {
+
+// ---------- 哈希策略 ----------
+
+// 两个哈希表程序原来使用的多项式哈希
+struct PolynomialHash {
+    size_t operator()(const std::string& key) const {
+        size_t hashValue = 0;
+        for (char c : key) {
+            hashValue = (hashValue * 31 + c) ^ (hashValue >> 7);
+        }
+        return hashValue;
+    }
+
+    size_t operator()(uint64_t key) const {
+        size_t hashValue = 0;
+        for (int i = 0; i < 8; ++i) {
+            hashValue = (hashValue * 31 + (key & 0xff)) ^ (hashValue >> 7);
+            key >>= 8;
+        }
+        return hashValue;
+    }
+};
+
+// 多项式哈希后再做一次 64 位混合，使低位（掩码取到的部分）足够随机
+struct MixHash {
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+
+    size_t operator()(const std::string& key) const {
+        return (size_t)mix(PolynomialHash()(key));
+    }
+
+    size_t operator()(uint64_t key) const {
+        return (size_t)mix(key);
+    }
+};
+
+// FNV-1a
+struct FnvHash {
+    size_t operator()(const std::string& key) const {
+        uint64_t hashValue = 14695981039346656037ULL;
+        for (char c : key) {
+            hashValue = (hashValue ^ (unsigned char)c) * 1099511628211ULL;
+        }
+        return (size_t)hashValue;
+    }
+
+    size_t operator()(uint64_t key) const {
+        uint64_t hashValue = 14695981039346656037ULL;
+        for (int i = 0; i < 8; ++i) {
+            hashValue = (hashValue ^ (key & 0xff)) * 1099511628211ULL;
+            key >>= 8;
+        }
+        return (size_t)hashValue;
+    }
+};
+
+// ---------- 探测策略 ----------
+// next(index, step, mask) 给出第 step 次冲突（从 1 开始）后的下一个槽位，
+// 在 2 的幂大小的表上都能遍历所有槽位
+
+struct LinearProbe {
+    static size_t next(size_t index, size_t, size_t mask) {
+        return (index + 1) & mask;
+    }
+};
+
+// 三角数序列 h, h+1, h+3, h+6, ...，是 2 的幂大小表上的二次探测
+struct QuadraticProbe {
+    static size_t next(size_t index, size_t step, size_t mask) {
+        return (index + step) & mask;
+    }
+};
+
+// ---------- 扩容策略 ----------
+// 已用槽位（元素与墓碑）超过 Num/Den 时扩容，每次槽位数乘以 Factor
+
+template <size_t Num, size_t Den, size_t Factor = 2>
+struct GrowAtLoad {
+    static_assert(Num < Den, "load factor must be below 1 so that probing always finds an empty slot");
+    static_assert(Factor >= 2 && (Factor & (Factor - 1)) == 0, "growth factor must be a power of two");
+
+    static bool needsGrow(size_t used, size_t capacity) {
+        return used * Den > capacity * Num;
+    }
+
+    static size_t grow(size_t capacity) {
+        return capacity * Factor;
+    }
+};
+
+template <typename Key, typename Value,
+    typename HashPolicy = MixHash,
+    typename ProbePolicy = LinearProbe,
+    typename GrowthPolicy = GrowAtLoad<4, 5>>
+class ExternalHashTable {
+private:
+    enum SlotState : unsigned char { SLOT_EMPTY = 0, SLOT_OCCUPIED = 1, SLOT_DELETED = 2 };
+
+    struct Slot {
+        Key key;
+        Value value;
+    };
+
+    std::vector<unsigned char> states; // 槽位状态，与 slots 一一对应
+    std::vector<Slot> slots;
+    size_t mask;         // 槽位数 - 1
+    size_t num_elements; // 当前已存储的元素个数
+    size_t num_deleted;  // 当前墓碑个数
+    HashPolicy hasher;
+
+public:
+    explicit ExternalHashTable(size_t size = 16) : mask(0), num_elements(0), num_deleted(0) {
+        allocate(roundUp(size));
+    }
+
+    // 插入或覆盖；返回是否为新键
+    bool insert(const Key& key, const Value& value) {
+        size_t hashValue = hasher(key);
+        size_t index = locate(key, hashValue);
+        if (index != capacity()) {
+            slots[index].value = value;
+            return false;
+        }
+
+        if (GrowthPolicy::needsGrow(num_elements + num_deleted + 1, capacity())) {
+            // 元素本身超过阈值时扩容，否则原尺寸重建以清理墓碑
+            rehash(GrowthPolicy::needsGrow(num_elements + 1, capacity())
+                ? GrowthPolicy::grow(capacity()) : capacity());
+        }
+
+        index = findInsertSlot(hashValue);
+        if (states[index] == SLOT_DELETED) {
+            --num_deleted;
+        }
+        states[index] = SLOT_OCCUPIED;
+        slots[index].key = key;
+        slots[index].value = value;
+        ++num_elements;
+        return true;
+    }
+
+    // 返回表内值的指针，不存在时返回 nullptr
+    Value* search(const Key& key) {
+        size_t index = locate(key, hasher(key));
+        return index == capacity() ? nullptr : &slots[index].value;
+    }
+
+    // 返回值的副本，不存在时返回默认值
+    Value find(const Key& key) {
+        Value* value = search(key);
+        return value ? *value : Value();
+    }
+
+    // 删除键；返回是否删除成功
+    bool erase(const Key& key) {
+        size_t index = locate(key, hasher(key));
+        if (index == capacity()) {
+            return false;
+        }
+        states[index] = SLOT_DELETED;
+        slots[index] = Slot();
+        --num_elements;
+        ++num_deleted;
+        return true;
+    }
+
+    // 预留容量，装入 count 个元素前不再扩容
+    void reserve(size_t count) {
+        size_t target = capacity();
+        while (GrowthPolicy::needsGrow(count, target)) {
+            target = GrowthPolicy::grow(target);
+        }
+        if (target != capacity()) {
+            rehash(target);
+        }
+    }
+
+    // 依次对每个元素调用 visit(key, value)
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (states[i] == SLOT_OCCUPIED) {
+                visit(slots[i].key, slots[i].value);
+            }
+        }
+    }
+
+    size_t size() const { return num_elements; }
+    size_t capacity() const { return mask + 1; }
+
+private:
+    static size_t roundUp(size_t size) {
+        size_t rounded = 16;
+        while (rounded < size) {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    void allocate(size_t new_capacity) {
+        states.assign(new_capacity, SLOT_EMPTY);
+        slots.assign(new_capacity, Slot());
+        mask = new_capacity - 1;
+        num_deleted = 0;
+    }
+
+    // 返回 key 所在槽位，不存在时返回 capacity()
+    size_t locate(const Key& key, size_t hashValue) const {
+        size_t index = hashValue & mask;
+        for (size_t step = 1; states[index] != SLOT_EMPTY; ++step) {
+            if (states[index] == SLOT_OCCUPIED && slots[index].key == key) {
+                return index;
+            }
+            index = ProbePolicy::next(index, step, mask);
+        }
+        return capacity();
+    }
+
+    // 沿同样的探测序列找第一个空槽或墓碑
+    size_t findInsertSlot(size_t hashValue) const {
+        size_t index = hashValue & mask;
+        for (size_t step = 1; states[index] == SLOT_OCCUPIED; ++step) {
+            index = ProbePolicy::next(index, step, mask);
+        }
+        return index;
+    }
+
+    void rehash(size_t new_capacity) {
+        std::vector<unsigned char> old_states;
+        std::vector<Slot> old_slots;
+        old_states.swap(states);
+        old_slots.swap(slots);
+        allocate(new_capacity);
+
+        for (size_t i = 0; i < old_states.size(); ++i) {
+            if (old_states[i] == SLOT_OCCUPIED) {
+                size_t index = findInsertSlot(hasher(old_slots[i].key));
+                states[index] = SLOT_OCCUPIED;
+                slots[index] = std::move(old_slots[i]);
+            }
+        }
+    }
+};
+
+} // namespace hashing
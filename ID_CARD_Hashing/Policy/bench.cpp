@@ -0,0 +1,128 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include "ExternalHashTable.h"
+#include "../Probe-Rehasing/PersonInfo.h"
+#include "../Probe-Rehasing/PackedId.h"
+
+using namespace std;
+using namespace hashing;
+
+// 生成随机身份证号（17 位随机数字 + 校验码，与 Data.py 相同）
+vector<string> generateIds(size_t count, unsigned seed) {
+    static const int weight[17] = { 7, 9, 10, 5, 8, 4, 2, 1, 6, 3, 7, 9, 10, 5, 8, 4, 2 };
+    static const char check_code_map[] = "10X98765432";
+
+    mt19937_64 rng(seed);
+    vector<string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        string id(18, '0');
+        int total = 0;
+        id[0] = char('1' + rng() % 9);
+        for (int j = 1; j < 17; ++j) {
+            id[j] = char('0' + rng() % 10);
+        }
+        for (int j = 0; j < 17; ++j) {
+            total += (id[j] - '0') * weight[j];
+        }
+        id[17] = check_code_map[total % 11];
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+// 身份证号转换为表的键类型；转换耗时计入测量
+inline const string& toKey(const string& id, const string*) { return id; }
+inline uint64_t toKey(const string& id, const uint64_t*) { return packId(id); }
+
+// 建表（从默认大小开始，含全部扩容）后分别测命中与未命中的查找吞吐
+template <typename Table, typename Key>
+void runCase(const char* key_name, const char* hash_name, const char* probe_name, const char* growth_name,
+    const vector<string>& ids, const vector<string>& hits, const vector<string>& misses) {
+    const Key* tag = nullptr;
+    Table hashTable;
+    PersonInfo person("张三", "Male", "2000-01-01", "广州", "13800000000");
+
+    auto start = chrono::steady_clock::now();
+    for (const string& id : ids) {
+        hashTable.insert(toKey(id, tag), person);
+    }
+    chrono::duration<double> build = chrono::steady_clock::now() - start;
+
+    size_t found_hit = 0, found_miss = 0;
+    start = chrono::steady_clock::now();
+    for (const string& id : hits) {
+        found_hit += hashTable.search(toKey(id, tag)) != nullptr;
+    }
+    chrono::duration<double> hit = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (const string& id : misses) {
+        found_miss += hashTable.search(toKey(id, tag)) != nullptr;
+    }
+    chrono::duration<double> miss = chrono::steady_clock::now() - start;
+
+    printf("%-7s %-11s %-10s %-7s %9.2f %9.2f %9.2f %9zu\n", key_name, hash_name, probe_name, growth_name,
+        ids.size() / build.count() / 1e6, hits.size() / hit.count() / 1e6, misses.size() / miss.count() / 1e6,
+        hashTable.capacity());
+    if (found_hit != hits.size() || found_miss != 0) {
+        cerr << "Lookup mismatch: found " << found_hit << " / " << found_miss << endl;
+    }
+}
+
+template <typename Key, typename Hash, typename Probe>
+void runGrowth(const char* key_name, const char* hash_name, const char* probe_name,
+    const vector<string>& ids, const vector<string>& hits, const vector<string>& misses) {
+    runCase<ExternalHashTable<Key, PersonInfo, Hash, Probe, GrowAtLoad<1, 2>>, Key>(
+        key_name, hash_name, probe_name, "0.5", ids, hits, misses);
+    runCase<ExternalHashTable<Key, PersonInfo, Hash, Probe, GrowAtLoad<4, 5>>, Key>(
+        key_name, hash_name, probe_name, "0.8", ids, hits, misses);
+}
+
+template <typename Key, typename Hash>
+void runProbe(const char* key_name, const char* hash_name,
+    const vector<string>& ids, const vector<string>& hits, const vector<string>& misses) {
+    runGrowth<Key, Hash, LinearProbe>(key_name, hash_name, "linear", ids, hits, misses);
+    runGrowth<Key, Hash, QuadraticProbe>(key_name, hash_name, "quadratic", ids, hits, misses);
+}
+
+template <typename Key>
+void runHash(const char* key_name, const vector<string>& ids, const vector<string>& hits, const vector<string>& misses) {
+    runProbe<Key, PolynomialHash>(key_name, "polynomial", ids, hits, misses);
+    runProbe<Key, MixHash>(key_name, "mix", ids, hits, misses);
+    runProbe<Key, FnvHash>(key_name, "fnv1a", ids, hits, misses);
+}
+
+// 键类型 × 哈希 × 探测 × 扩容阈值 的全部组合
+void benchMatrix(size_t count) {
+    vector<string> ids = generateIds(count, 1);
+    vector<string> misses = generateIds(count, 2);
+    vector<string> hits = ids;
+    shuffle(hits.begin(), hits.end(), mt19937_64(3));
+
+    printf("%zu keys; Mops/s for build (from 16 slots), hit lookup, miss lookup\n", count);
+    printf("key     hash        probe      load        build       hit      miss     slots\n");
+    runHash<string>("string", ids, hits, misses);
+    runHash<uint64_t>("packed", ids, hits, misses);
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "matrix";
+    size_t count = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+    if (mode == "matrix") {
+        benchMatrix(count);
+    }
+    else {
+        cerr << "Unknown benchmark: " << mode << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,425 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <cstdint>
+#include "PersonInfo.h"
+#include "PackedId.h"
+
+// 多线程并发的开放寻址哈希表：线性探测，身份证号压缩成 64 位键。
+// 插入时用 CAS 把空槽的键从 0 改成自己的键来占位，再用 CAS 发布值指针；键一旦写入不再改变，
+// 删除只把值指针置空。查找全程只做原子读，不加锁。
+// 扩容由发现负载过高的线程建好新表，此后所有写线程按块（kMigrateChunk 个槽位）分摊搬迁，
+// 搬迁一个槽位时先把值指针最低位置 1 冻结（写操作随即失败并转去新表，读操作照常读取），
+// 复制到新表后再换成 kMoved，读线程遇到 kMoved 就转到新表继续查。
+// 只有 search 是无锁的；写操作在扩容期间要等所有已领取的块搬完，搬迁某块的线程被挂起时其他写线程都会停住，
+// 因此扩容期间的 insert/erase 是阻塞的。
+// 被覆盖、删除的个人信息和搬空的旧表不会立即释放（读线程可能还在用），
+// 在析构或调用 reclaim() 时统一回收，search 返回的指针在此之前一直有效。
+class ConcurrentHashTable {
+private:
+    struct ValueNode {
+        PersonInfo person;
+        ValueNode* retired_next; // 退役链表
+
+        explicit ValueNode(PersonInfo&& p) : person(std::move(p)), retired_next(nullptr) {}
+    };
+
+    struct Table {
+        size_t capacity;                          // 槽位数，2 的幂
+        std::atomic<uint64_t>* keys;              // 0 表示空槽
+        std::atomic<ValueNode*>* values;          // nullptr 表示尚未发布或已删除
+        std::atomic<size_t> used;                 // 已占用的键槽位（含已删除的）
+        std::atomic<Table*> next;                 // 扩容后的新表
+        std::atomic<size_t> migrate_claimed;      // 已被领取的搬迁块数
+        std::atomic<size_t> migrate_done;         // 已搬完的块数
+        Table* retired_next;                      // 退役链表
+
+        explicit Table(size_t size)
+            : capacity(size), keys(new std::atomic<uint64_t>[size]), values(new std::atomic<ValueNode*>[size]),
+            used(0), next(nullptr), migrate_claimed(0), migrate_done(0), retired_next(nullptr) {
+            for (size_t i = 0; i < size; ++i) {
+                keys[i].store(0, std::memory_order_relaxed);
+                values[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~Table() {
+            delete[] keys;
+            delete[] values;
+        }
+
+        size_t chunkCount() const {
+            return (capacity + kMigrateChunk - 1) / kMigrateChunk;
+        }
+    };
+
+    static const size_t kMigrateChunk = 4096;
+
+    std::atomic<Table*> current;
+    std::atomic<size_t> num_elements;
+    std::atomic<ValueNode*> retired_values;
+    std::atomic<Table*> retired_tables;
+    std::atomic<size_t> resize_count;
+
+public:
+    ConcurrentHashTable(size_t size = 1024)
+        : num_elements(0), retired_values(nullptr), retired_tables(nullptr), resize_count(0) {
+        size_t rounded = 16;
+        while (rounded < size) {
+            rounded *= 2;
+        }
+        current.store(new Table(rounded));
+    }
+
+    ~ConcurrentHashTable() {
+        reclaim();
+        Table* table = current.load();
+        for (size_t i = 0; i < table->capacity; ++i) {
+            ValueNode* node = table->values[i].load();
+            if (node != nullptr && !isFrozen(node)) {
+                delete node;
+            }
+        }
+        delete table;
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    // 从CSV文件加载数据
+    void loadFromFile(const std::string& filename) {
+        std::ifstream infile(filename);
+
+        if (!infile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+
+        std::string line;
+        std::getline(infile, line); // 跳过文件表头
+
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string id, name, gender, birthdate, address, phone;
+
+            std::getline(ss, id, ',');
+            std::getline(ss, name, ',');
+            std::getline(ss, gender, ',');
+            std::getline(ss, birthdate, ',');
+            std::getline(ss, address, ',');
+            std::getline(ss, phone, ',');
+
+            insert(id, name, gender, birthdate, address, phone);
+        }
+    }
+
+    // 插入数据到哈希表，身份证号已存在时覆盖；可由多个线程同时调用
+    void insert(const std::string& id, const std::string& name, const std::string& gender,
+        const std::string& birthdate, const std::string& address, const std::string& phone) {
+        uint64_t key = packId(id);
+        if (key == 0) {
+            std::cerr << "Invalid ID card number: " << id << std::endl;
+            return;
+        }
+
+        ValueNode* node = new ValueNode(PersonInfo(name, gender, birthdate, address, phone));
+        Table* table = writableTable();
+
+        for (;;) {
+            size_t index = claimSlot(table, key);
+            if (index == table->capacity) {
+                table = startResize(table); // 表已满或超过负载因子
+                continue;
+            }
+
+            ValueNode* old = table->values[index].load(std::memory_order_acquire);
+            while (!isFrozen(old) && !table->values[index].compare_exchange_weak(old, node)) {
+            }
+            if (isFrozen(old)) {
+                table = helpMigrate(table); // 这个槽位已搬到新表
+                continue;
+            }
+
+            if (old == nullptr) {
+                num_elements.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                retire(old);
+            }
+            return;
+        }
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) {
+        PersonInfo* person = search(id);
+        return person ? *person : PersonInfo();
+    }
+
+    // 查找身份证号对应的个人信息，返回表内指针，不存在时返回 nullptr（不复制数据）。
+    // 不加锁，也不参与搬迁
+    PersonInfo* search(const std::string& id) {
+        uint64_t key = packId(id);
+        if (key == 0) {
+            return nullptr;
+        }
+
+        Table* table = current.load(std::memory_order_acquire);
+        for (;;) {
+            size_t index = findSlot(table, key);
+            if (index == table->capacity) {
+                return nullptr;
+            }
+            ValueNode* node = table->values[index].load(std::memory_order_acquire);
+            if (node != kMoved()) {
+                node = unfrozen(node); // 冻结中的值仍是最新的
+                return node ? &node->person : nullptr;
+            }
+            table = table->next.load(std::memory_order_acquire);
+        }
+    }
+
+    // 删除身份证号对应的数据；返回是否删除成功
+    bool erase(const std::string& id) {
+        uint64_t key = packId(id);
+        if (key == 0) {
+            return false;
+        }
+
+        Table* table = writableTable();
+        for (;;) {
+            size_t index = findSlot(table, key);
+            if (index == table->capacity) {
+                return false;
+            }
+
+            ValueNode* old = table->values[index].load(std::memory_order_acquire);
+            while (old != nullptr && !isFrozen(old)
+                && !table->values[index].compare_exchange_weak(old, nullptr)) {
+            }
+            if (isFrozen(old)) {
+                table = helpMigrate(table);
+                continue;
+            }
+            if (old == nullptr) {
+                return false;
+            }
+
+            num_elements.fetch_sub(1, std::memory_order_relaxed);
+            retire(old);
+            return true;
+        }
+    }
+
+    size_t size() const { return num_elements.load(); }
+    size_t slotCount() const { return current.load()->capacity; }
+    size_t resizeCount() const { return resize_count.load(); }
+
+    // 释放被覆盖、删除的个人信息以及搬空的旧表。调用时不能有其他线程在使用本表，
+    // 之前 search 返回的指针随之失效
+    void reclaim() {
+        ValueNode* node = retired_values.exchange(nullptr);
+        while (node) {
+            ValueNode* next = node->retired_next;
+            delete node;
+            node = next;
+        }
+
+        Table* table = retired_tables.exchange(nullptr);
+        while (table) {
+            Table* next = table->retired_next;
+            delete table;
+            table = next;
+        }
+    }
+
+    // 将哈希表保存到文件；调用时不能有其他线程在写
+    void saveToFile(const std::string& filename) {
+        std::ofstream outfile(filename);
+
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+
+        Table* table = current.load();
+        for (size_t i = 0; i < table->capacity; ++i) {
+            ValueNode* node = table->values[i].load();
+            if (node != nullptr && !isFrozen(node)) {
+                const PersonInfo& person = node->person;
+                outfile << unpackId(table->keys[i].load()) << ","
+                    << person.name << ","
+                    << person.gender << ","
+                    << person.birthdate << ","
+                    << person.address << ","
+                    << person.phone << "\n";
+            }
+        }
+
+        outfile.close();
+        std::cout << "Data saved to file: " << filename << std::endl;
+    }
+
+private:
+    // 已搬到新表（或搬迁时本来就为空）的槽位的值指针，即冻结的 nullptr
+    static ValueNode* kMoved() {
+        return reinterpret_cast<ValueNode*>(static_cast<uintptr_t>(1));
+    }
+
+    static bool isFrozen(ValueNode* node) {
+        return (reinterpret_cast<uintptr_t>(node) & 1) != 0;
+    }
+
+    static ValueNode* unfrozen(ValueNode* node) {
+        return reinterpret_cast<ValueNode*>(reinterpret_cast<uintptr_t>(node) & ~static_cast<uintptr_t>(1));
+    }
+
+    // 写操作只在没有进行中的搬迁的表上进行；有的话先帮忙搬完
+    Table* writableTable() {
+        Table* table = current.load(std::memory_order_acquire);
+        while (table->next.load(std::memory_order_acquire)) {
+            table = helpMigrate(table);
+        }
+        return table;
+    }
+
+    // 返回 key 所在槽位，不存在时返回 capacity
+    static size_t findSlot(Table* table, uint64_t key) {
+        size_t mask = table->capacity - 1;
+        size_t index = (size_t)mixKey(key) & mask;
+        for (size_t probe = 0; probe < table->capacity; ++probe) {
+            uint64_t slot_key = table->keys[index].load(std::memory_order_acquire);
+            if (slot_key == key) {
+                return index;
+            }
+            if (slot_key == 0) {
+                return table->capacity;
+            }
+            index = (index + 1) & mask;
+        }
+        return table->capacity;
+    }
+
+    // 返回 key 已有的槽位，或者用 CAS 占一个空槽；超过负载因子 3/4 或表满时返回 capacity
+    static size_t claimSlot(Table* table, uint64_t key) {
+        size_t mask = table->capacity - 1;
+        size_t index = (size_t)mixKey(key) & mask;
+        for (size_t probe = 0; probe < table->capacity; ++probe) {
+            uint64_t slot_key = table->keys[index].load(std::memory_order_acquire);
+            if (slot_key == 0) {
+                if (table->used.load(std::memory_order_relaxed) * 4 >= table->capacity * 3) {
+                    return table->capacity;
+                }
+                if (table->keys[index].compare_exchange_strong(slot_key, key)) {
+                    table->used.fetch_add(1, std::memory_order_relaxed);
+                    return index;
+                }
+                // 被其他线程抢先占用，slot_key 已更新为对方的键
+            }
+            if (slot_key == key) {
+                return index;
+            }
+            index = (index + 1) & mask;
+        }
+        return table->capacity;
+    }
+
+    // 建新表并开始搬迁；多个线程同时发现时只有一个新表被装上
+    Table* startResize(Table* table) {
+        if (!table->next.load(std::memory_order_acquire)) {
+            // 存活元素超过一半时翻倍，否则原尺寸重建以清理已删除的键
+            size_t live = num_elements.load(std::memory_order_relaxed);
+            size_t new_capacity = live * 2 > table->capacity ? table->capacity * 2 : table->capacity;
+            Table* fresh = new Table(new_capacity);
+            Table* expected = nullptr;
+            if (table->next.compare_exchange_strong(expected, fresh)) {
+                resize_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+                delete fresh;
+            }
+        }
+        return helpMigrate(table);
+    }
+
+    // 领取并搬迁尚未搬的块，等所有块搬完后把新表设为当前表，返回新表。
+    // 别的线程领走的块只能等它搬完，这里会自旋等待
+    Table* helpMigrate(Table* table) {
+        Table* fresh = table->next.load(std::memory_order_acquire);
+        size_t chunks = table->chunkCount();
+
+        for (;;) {
+            size_t chunk = table->migrate_claimed.fetch_add(1);
+            if (chunk >= chunks) {
+                break;
+            }
+            size_t end = (chunk + 1) * kMigrateChunk;
+            if (end > table->capacity) {
+                end = table->capacity;
+            }
+            for (size_t i = chunk * kMigrateChunk; i < end; ++i) {
+                migrateSlot(table, fresh, i);
+            }
+            table->migrate_done.fetch_add(1, std::memory_order_release);
+        }
+
+        // 其他线程领走的块可能还没搬完
+        while (table->migrate_done.load(std::memory_order_acquire) < chunks) {
+            std::this_thread::yield();
+        }
+
+        Table* expected = table;
+        if (current.compare_exchange_strong(expected, fresh)) {
+            retireTable(table);
+        }
+        return fresh;
+    }
+
+    // 先冻结值指针，此后这个槽位上的写操作都会失败并转去新表；复制完成后再标记为 kMoved
+    void migrateSlot(Table* table, Table* fresh, size_t index) {
+        ValueNode* node = table->values[index].load(std::memory_order_acquire);
+        while (!table->values[index].compare_exchange_weak(node,
+            reinterpret_cast<ValueNode*>(reinterpret_cast<uintptr_t>(node) | 1))) {
+        }
+        if (node == nullptr) {
+            return;
+        }
+
+        // 搬迁全部完成之前新表上不会有写操作，也不会超过负载，直接找空槽放入
+        uint64_t key = table->keys[index].load(std::memory_order_acquire);
+        size_t mask = fresh->capacity - 1;
+        size_t slot = (size_t)mixKey(key) & mask;
+        for (;;) {
+            uint64_t expected = 0;
+            if (fresh->keys[slot].compare_exchange_strong(expected, key)) {
+                fresh->values[slot].store(node, std::memory_order_release);
+                fresh->used.fetch_add(1, std::memory_order_relaxed);
+                table->values[index].store(kMoved(), std::memory_order_release);
+                return;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    void retire(ValueNode* node) {
+        ValueNode* head = retired_values.load(std::memory_order_relaxed);
+        do {
+            node->retired_next = head;
+        } while (!retired_values.compare_exchange_weak(head, node));
+    }
+
+    void retireTable(Table* table) {
+        Table* head = retired_tables.load(std::memory_order_relaxed);
+        do {
+            table->retired_next = head;
+        } while (!retired_tables.compare_exchange_weak(head, table));
+    }
+};
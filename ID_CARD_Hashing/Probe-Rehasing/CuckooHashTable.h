@@ -0,0 +1,275 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include "PersonInfo.h"
+#include "PackedId.h"
+
+// 分桶布谷鸟哈希表：两个哈希函数 × 每桶 4 个槽位。
+// 身份证号压缩成 64 位整数存放在桶内，一个桶正好占一条 64 字节缓存行，
+// 查找最多读两个桶（两条缓存行），插入失败的少量元素放在 stash 中，查找最坏情况有上界。
+class CuckooHashTable {
+private:
+    static const size_t kSlotsPerBucket = 4;
+    static const size_t kMaxKicks = 500;  // 插入时最多踢出的次数，超过后放入 stash
+    static const size_t kStashSize = 8;   // stash 满了就扩容
+
+    struct alignas(64) Bucket {
+        uint64_t keys[kSlotsPerBucket];   // 压缩后的身份证号 + 1，0 表示空槽
+        uint32_t records[kSlotsPerBucket]; // 在 records 数组中的下标
+    };
+
+    struct StashEntry {
+        uint64_t key;
+        uint32_t record;
+    };
+
+    std::unique_ptr<unsigned char[]> bucket_storage;
+    Bucket* buckets;                   // 按 64 字节对齐，每个桶落在一条缓存行内
+    size_t bucket_count;               // 桶数，2 的幂
+    std::vector<StashEntry> stash;
+    std::vector<PersonInfo> records;   // 个人信息连续存放，删除时用最后一条补位
+    std::vector<uint64_t> record_keys; // records[i] 对应的键，补位时用来找到它所在的槽位
+    const double load_factor_threshold = 0.9; // 负载因子阈值
+    uint32_t kick_seed = 0;            // 选择被踢出槽位的简单伪随机序列
+
+public:
+    CuckooHashTable(size_t size = 1024) : buckets(nullptr), bucket_count(0) {
+        size_t count = 1;
+        while (count * kSlotsPerBucket < size) {
+            count *= 2;
+        }
+        allocateBuckets(count);
+    }
+
+    // 从CSV文件加载数据
+    void loadFromFile(const std::string& filename) {
+        std::ifstream infile(filename);
+
+        if (!infile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+
+        std::string line;
+        std::getline(infile, line); // 跳过文件表头
+
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string id, name, gender, birthdate, address, phone;
+
+            std::getline(ss, id, ',');
+            std::getline(ss, name, ',');
+            std::getline(ss, gender, ',');
+            std::getline(ss, birthdate, ',');
+            std::getline(ss, address, ',');
+            std::getline(ss, phone, ',');
+
+            insert(id, name, gender, birthdate, address, phone);
+        }
+    }
+
+    // 插入数据到哈希表，身份证号已存在时覆盖
+    void insert(const std::string& id, const std::string& name, const std::string& gender,
+        const std::string& birthdate, const std::string& address, const std::string& phone) {
+        uint64_t key = packId(id);
+        if (key == 0) {
+            std::cerr << "Invalid ID card number: " << id << std::endl;
+            return;
+        }
+
+        uint32_t* record = findRecord(key);
+        if (record) {
+            records[*record] = PersonInfo(name, gender, birthdate, address, phone);
+            return;
+        }
+
+        if ((double)(records.size() + 1) / (bucket_count * kSlotsPerBucket) > load_factor_threshold) {
+            rehash(bucket_count * 2);
+        }
+
+        records.emplace_back(name, gender, birthdate, address, phone);
+        record_keys.push_back(key);
+        if (!place(key, (uint32_t)(records.size() - 1))) {
+            rehash(bucket_count * 2); // stash 已满，扩容后重新放置全部键（包括这一个）
+        }
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) {
+        PersonInfo* person = search(id);
+        return person ? *person : PersonInfo();
+    }
+
+    // 查找身份证号对应的个人信息，返回表内指针，不存在时返回 nullptr（不复制数据）
+    PersonInfo* search(const std::string& id) {
+        uint64_t key = packId(id);
+        uint32_t* record = key ? findRecord(key) : nullptr;
+        return record ? &records[*record] : nullptr;
+    }
+
+    // 删除身份证号对应的数据；返回是否删除成功
+    bool erase(const std::string& id) {
+        uint64_t key = packId(id);
+        uint32_t* record = key ? findRecord(key) : nullptr;
+        if (!record) {
+            return false;
+        }
+
+        uint32_t index = *record;
+        removeKey(key);
+
+        // 用最后一条记录填补空位，并修改指向它的槽位
+        uint32_t last = (uint32_t)(records.size() - 1);
+        if (index != last) {
+            records[index] = std::move(records[last]);
+            record_keys[index] = record_keys[last];
+            *findRecord(record_keys[index]) = index;
+        }
+        records.pop_back();
+        record_keys.pop_back();
+        return true;
+    }
+
+    size_t size() const { return records.size(); }
+    size_t slotCount() const { return bucket_count * kSlotsPerBucket; }
+    size_t stashSize() const { return stash.size(); }
+
+    // 将哈希表保存到文件
+    void saveToFile(const std::string& filename) {
+        std::ofstream outfile(filename);
+
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+
+        for (size_t i = 0; i < records.size(); ++i) {
+            outfile << unpackId(record_keys[i]) << ","
+                << records[i].name << ","
+                << records[i].gender << ","
+                << records[i].birthdate << ","
+                << records[i].address << ","
+                << records[i].phone << "\n";
+        }
+
+        outfile.close();
+        std::cout << "Data saved to file: " << filename << std::endl;
+    }
+
+private:
+    // 两个候选桶分别取混合后哈希值的低位与高位
+    size_t bucket1(uint64_t key) const {
+        return (size_t)mixKey(key) & (bucket_count - 1);
+    }
+
+    size_t bucket2(uint64_t key) const {
+        return (size_t)(mixKey(key) >> 32) & (bucket_count - 1);
+    }
+
+    // 返回 key 所在槽位上的记录下标指针，不存在时返回 nullptr
+    uint32_t* findRecord(uint64_t key) {
+        for (size_t b : { bucket1(key), bucket2(key) }) {
+            Bucket& bucket = buckets[b];
+            for (size_t i = 0; i < kSlotsPerBucket; ++i) {
+                if (bucket.keys[i] == key) {
+                    return &bucket.records[i];
+                }
+            }
+        }
+        for (StashEntry& entry : stash) {
+            if (entry.key == key) {
+                return &entry.record;
+            }
+        }
+        return nullptr;
+    }
+
+    void removeKey(uint64_t key) {
+        for (size_t b : { bucket1(key), bucket2(key) }) {
+            Bucket& bucket = buckets[b];
+            for (size_t i = 0; i < kSlotsPerBucket; ++i) {
+                if (bucket.keys[i] == key) {
+                    bucket.keys[i] = 0;
+                    return;
+                }
+            }
+        }
+        for (size_t i = 0; i < stash.size(); ++i) {
+            if (stash[i].key == key) {
+                stash.erase(stash.begin() + i);
+                return;
+            }
+        }
+    }
+
+    bool tryPut(size_t b, uint64_t key, uint32_t record) {
+        Bucket& bucket = buckets[b];
+        for (size_t i = 0; i < kSlotsPerBucket; ++i) {
+            if (bucket.keys[i] == 0) {
+                bucket.keys[i] = key;
+                bucket.records[i] = record;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 放入一个已知不在表中的键：两个候选桶都满时随机踢出一个槽位，被踢出的键换到它的另一个候选桶。
+    // 踢出次数用完时把最后无处可去的键放进 stash，stash 超过上限时返回 false
+    bool place(uint64_t key, uint32_t record) {
+        size_t b = bucket1(key);
+        if (tryPut(b, key, record) || tryPut(bucket2(key), key, record)) {
+            return true;
+        }
+
+        for (size_t kick = 0; kick < kMaxKicks; ++kick) {
+            kick_seed = kick_seed * 1103515245 + 12345;
+            size_t victim = (kick_seed >> 16) % kSlotsPerBucket;
+            Bucket& bucket = buckets[b];
+            std::swap(key, bucket.keys[victim]);
+            std::swap(record, bucket.records[victim]);
+
+            b = bucket1(key) == b ? bucket2(key) : bucket1(key);
+            if (tryPut(b, key, record)) {
+                return true;
+            }
+        }
+
+        stash.push_back({ key, record });
+        return stash.size() <= kStashSize;
+    }
+
+    void allocateBuckets(size_t count) {
+        bucket_storage.reset(new unsigned char[count * sizeof(Bucket) + 63]);
+        uintptr_t address = reinterpret_cast<uintptr_t>(bucket_storage.get());
+        buckets = reinterpret_cast<Bucket*>((address + 63) & ~(uintptr_t)63);
+        std::memset(static_cast<void*>(buckets), 0, count * sizeof(Bucket));
+        bucket_count = count;
+        stash.clear();
+    }
+
+    // 重建桶数组；记录数组不动，只重新放置键。放不下时继续翻倍
+    void rehash(size_t new_bucket_count) {
+        for (;;) {
+            allocateBuckets(new_bucket_count);
+            size_t i = 0;
+            while (i < records.size() && place(record_keys[i], (uint32_t)i)) {
+                ++i;
+            }
+            if (i == records.size()) {
+                return;
+            }
+            new_bucket_count *= 2;
+        }
+    }
+};
@@ -0,0 +1,776 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include "PersonInfo.h"
+
+// 哈希表运行统计，dump() 输出单行 JSON 便于采集
+struct HashTableStats {
+    size_t num_elements = 0;
+    size_t num_tombstones = 0;
+    size_t table_size = 0;
+    double load_factor = 0;
+    std::vector<size_t> probe_length_histogram; // [i] 为需要 i+1 次探测才能找到的元素个数，最后一格包含更长的
+    size_t successful_finds = 0;
+    size_t successful_probes = 0;
+    size_t max_successful_probes = 0;
+    size_t unsuccessful_finds = 0;
+    size_t unsuccessful_probes = 0;
+    size_t max_unsuccessful_probes = 0;
+    size_t rehash_count = 0;        // 含原尺寸重建
+    size_t compaction_count = 0;    // 原尺寸清理墓碑的次数
+    double rehash_seconds = 0;      // 所有扩容累计耗时
+    double last_rehash_seconds = 0; // 最近一次扩容耗时
+    size_t bytes_used = 0;
+
+    double averageSuccessfulProbes() const {
+        return successful_finds ? (double)successful_probes / successful_finds : 0;
+    }
+
+    double averageUnsuccessfulProbes() const {
+        return unsuccessful_finds ? (double)unsuccessful_probes / unsuccessful_finds : 0;
+    }
+
+    void dump(std::ostream& out) const {
+        out << "{\"num_elements\":" << num_elements
+            << ",\"num_tombstones\":" << num_tombstones
+            << ",\"table_size\":" << table_size
+            << ",\"load_factor\":" << load_factor
+            << ",\"probe_length_histogram\":[";
+        for (size_t i = 0; i < probe_length_histogram.size(); ++i) {
+            out << (i ? "," : "") << probe_length_histogram[i];
+        }
+        out << "],\"successful_finds\":" << successful_finds
+            << ",\"avg_successful_probes\":" << averageSuccessfulProbes()
+            << ",\"max_successful_probes\":" << max_successful_probes
+            << ",\"unsuccessful_finds\":" << unsuccessful_finds
+            << ",\"avg_unsuccessful_probes\":" << averageUnsuccessfulProbes()
+            << ",\"max_unsuccessful_probes\":" << max_unsuccessful_probes
+            << ",\"rehash_count\":" << rehash_count
+            << ",\"compaction_count\":" << compaction_count
+            << ",\"rehash_seconds\":" << rehash_seconds
+            << ",\"last_rehash_seconds\":" << last_rehash_seconds
+            << ",\"bytes_used\":" << bytes_used << "}" << std::endl;
+    }
+};
+
+// 槽位状态
+enum SlotState : unsigned char {
+    SLOT_EMPTY = 0,    // 从未使用过，探测到此处即可停止
+    SLOT_OCCUPIED = 1, // 存有数据
+    SLOT_DELETED = 2   // 墓碑：数据已删除，但探测链不能在此中断
+};
+
+const size_t kIdLength = 18; // 身份证号长度
+
+// 槽位中参与探测的部分：定长内联的身份证号、槽位状态与缓存的哈希值，共 24 字节。
+// 探测与扩容只读这一部分，不访问堆内存也不重新计算哈希
+struct KeySlot {
+    char id[kIdLength];
+    unsigned char state;    // SlotState
+    unsigned char reserved;
+    uint32_t hash;
+};
+
+// 镜像文件（saveImage 写出，MappedHashTable 只读映射）的布局：
+// ImageHeader | slot_count 个 ImageSlot | 记录堆。槽位按表内位置原样写出（含墓碑），
+// 打开后沿用同样的哈希与探测序列；记录为 kImageFields 个 uint32 长度后接各字段字节。按本机字节序存放
+const char kImageMagic[8] = { 'I', 'D', 'H', 'T', 'I', 'M', 'G', '1' };
+const uint32_t kImageVersion = 1;
+const size_t kImageFields = 5; // 姓名、性别、生日、地址、电话
+
+struct ImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slot_bytes;   // sizeof(ImageSlot)，打开时校验
+    uint64_t slot_count;
+    uint64_t num_elements;
+    uint64_t heap_bytes;
+    uint64_t reserved[3];
+};
+
+struct ImageSlot {
+    KeySlot key;
+    uint64_t record; // 记录在记录堆中的偏移
+};
+
+static_assert(sizeof(ImageHeader) == 64, "ImageHeader layout changed");
+static_assert(sizeof(ImageSlot) == 32, "ImageSlot layout changed");
+
+// 槽位数组：键数组用 calloc 申请（全零即 SLOT_EMPTY，大块内存由系统按页延迟清零），
+// 个人信息数组只申请原始内存，仅 SLOT_OCCUPIED 的槽位上构造了对象，因此新建一张大表不需要逐个构造空槽
+class SlotArray {
+public:
+    size_t size;   // 槽位数
+    size_t count;  // 已构造的元素个数
+    KeySlot* keys;
+
+    explicit SlotArray(size_t n = 0)
+        : size(n), count(0), keys(nullptr), values(nullptr) {
+        if (n) {
+            keys = static_cast<KeySlot*>(std::calloc(n, sizeof(KeySlot)));
+            values = static_cast<PersonInfo*>(std::malloc(n * sizeof(PersonInfo)));
+            if (!keys || !values) {
+                std::free(keys);
+                std::free(values);
+                throw std::bad_alloc();
+            }
+        }
+    }
+
+    SlotArray(SlotArray&& other) noexcept
+        : size(other.size), count(other.count), keys(other.keys), values(other.values) {
+        other.size = other.count = 0;
+        other.keys = nullptr;
+        other.values = nullptr;
+    }
+
+    SlotArray& operator=(SlotArray&& other) noexcept {
+        if (this != &other) {
+            release();
+            size = other.size;
+            count = other.count;
+            keys = other.keys;
+            values = other.values;
+            other.size = other.count = 0;
+            other.keys = nullptr;
+            other.values = nullptr;
+        }
+        return *this;
+    }
+
+    SlotArray(const SlotArray&) = delete;
+    SlotArray& operator=(const SlotArray&) = delete;
+
+    ~SlotArray() { release(); }
+
+    unsigned char state(size_t i) const { return keys[i].state; }
+    PersonInfo& value(size_t i) { return values[i]; }
+    const PersonInfo& value(size_t i) const { return values[i]; }
+
+    // 在空槽或墓碑上构造元素
+    void put(size_t i, const KeySlot& key, PersonInfo&& person) {
+        construct(i, key, std::move(person));
+        ++count;
+    }
+
+    // 同 put，但不更新 count；供多个线程各自写入不同槽位，结束后由调用方设置 count
+    void construct(size_t i, const KeySlot& key, PersonInfo&& person) {
+        keys[i] = key;
+        keys[i].state = SLOT_OCCUPIED;
+        new (&values[i]) PersonInfo(std::move(person));
+    }
+
+    // 析构槽位上的元素并留下墓碑；身份证号与哈希值一并清零，已删除的号码不会残留在内存或写进镜像
+    void remove(size_t i) {
+        values[i].~PersonInfo();
+        std::memset(&keys[i], 0, sizeof(KeySlot));
+        keys[i].state = SLOT_DELETED;
+        --count;
+    }
+
+private:
+    PersonInfo* values;
+
+    void release() {
+        for (size_t i = 0; count > 0 && i < size; ++i) {
+            if (keys[i].state == SLOT_OCCUPIED) {
+                values[i].~PersonInfo();
+                --count;
+            }
+        }
+        std::free(keys);
+        std::free(values);
+        keys = nullptr;
+        values = nullptr;
+        size = 0;
+    }
+};
+
+// 扩容方式
+enum class RehashMode {
+    StopTheWorld, // 超过阈值时在一次 insert 中搬完所有元素
+    Incremental   // 新旧两表并存，之后每次 insert/erase 只搬 kMigrateSlots 个旧槽位
+};
+
+class MappedHashTable;
+
+// 哈希表类
+class ExternalHashTable {
+    friend class MappedHashTable; // 共用 makeKey 与探测序列
+
+private:
+    SlotArray table;     // 当前表（渐进扩容时为新表）
+    SlotArray old_table; // 渐进扩容中尚未搬完的旧表，size 为 0 表示没有在扩容
+    size_t migrate_pos;  // 旧表中下一个待搬的槽位
+    double migrate_seconds = 0; // 本轮渐进扩容累计耗时
+    RehashMode mode;
+    size_t num_elements; // 当前已存储的元素个数（新旧两表合计）
+    size_t num_tombstones; // 当前表中的墓碑个数
+    const double load_factor_threshold; // 负载因子阈值（元素与墓碑合计）
+    const double tombstone_threshold = 0.2; // 墓碑占比超过该值时原尺寸重建
+    static const size_t kMigrateSlots = 16; // 渐进扩容时每次操作搬动的旧槽位数
+    static const size_t kParallelRehashSlots = 1 << 20; // 旧表槽位数达到该值时多线程重建
+    size_t rehash_threads; // 一次性重建使用的线程数
+    static const size_t kHistogramBins = 32; // 探测长度直方图的格数
+    HashTableStats counters; // 查找与扩容计数，只做整数累加，常开开销很小
+
+public:
+    ExternalHashTable(size_t size = 1024, RehashMode rehash_mode = RehashMode::StopTheWorld, double max_load_factor = 0.8)
+        : table(size), migrate_pos(0), mode(rehash_mode), num_elements(0), num_tombstones(0),
+        load_factor_threshold(max_load_factor) {
+        rehash_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    // 从CSV文件加载数据
+    // presize 为 true 时先按文件大小估算行数并一次性预留槽位，加载过程中不再扩容
+    void loadFromFile(const std::string& filename, bool presize = true) {
+        std::ifstream infile(filename);
+
+        if (!infile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+
+        std::string line;
+        std::getline(infile, line); // 跳过文件表头
+
+        if (presize) {
+            reserve(num_elements + estimateRowCount(infile));
+        }
+
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string id, name, gender, birthdate, address, phone;
+
+            std::getline(ss, id, ',');
+            std::getline(ss, name, ',');
+            std::getline(ss, gender, ',');
+            std::getline(ss, birthdate, ',');
+            std::getline(ss, address, ',');
+            std::getline(ss, phone, ',');
+
+            insert(id, name, gender, birthdate, address, phone);
+        }
+    }
+
+    // 插入数据到哈希表
+    void insert(const std::string& id, const std::string& name, const std::string& gender,
+        const std::string& birthdate, const std::string& address, const std::string& phone) {
+        // 先校验身份证号，非法的行不触发也不推进扩容
+        KeySlot key;
+        if (!makeKey(id, key)) {
+            std::cerr << "Invalid ID card number: " << id << std::endl;
+            return;
+        }
+
+        if (migrating()) {
+            migrateStep();
+        }
+        else if ((double)(num_elements + num_tombstones) / table.size > load_factor_threshold) {
+            // 墓碑多时原尺寸重建即可腾出空间，否则扩容
+            startRehash(num_tombstones > num_elements / 4 ? table.size : table.size * 2);
+        }
+
+        if (migrating()) {
+            size_t probes = 0;
+            size_t old_index = probeFind(old_table, key, probes);
+            if (old_index != old_table.size) {
+                old_table.value(old_index) = PersonInfo(name, gender, birthdate, address, phone);
+                return;
+            }
+        }
+
+        size_t index = key.hash % table.size;
+        size_t original_index = index;
+        size_t probe = 1;
+        size_t reuse = table.size; // 探测路径上遇到的第一个墓碑
+
+        while (table.state(index) != SLOT_EMPTY) {
+            if (table.state(index) == SLOT_OCCUPIED && sameKey(table.keys[index], key)) {
+                table.value(index) = PersonInfo(name, gender, birthdate, address, phone);
+                return;
+            }
+            if (table.state(index) == SLOT_DELETED && reuse == table.size) {
+                reuse = index;
+            }
+            index = (original_index + probe * probe) % table.size; // 二次探测
+            ++probe;
+        }
+
+        if (reuse != table.size) {
+            index = reuse; // 复用墓碑，缩短之后的探测链
+            --num_tombstones;
+        }
+        table.put(index, key, PersonInfo(name, gender, birthdate, address, phone));
+        ++num_elements;
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) {
+        PersonInfo* person = search(id);
+        return person ? *person : PersonInfo();
+    }
+
+    // 查找身份证号对应的个人信息，返回表内指针，不存在时返回 nullptr（不复制数据）
+    PersonInfo* search(const std::string& id) {
+        size_t index;
+        SlotArray* where = locate(id, index);
+        return where ? &where->value(index) : nullptr;
+    }
+
+    // 删除身份证号对应的数据，槽位留下墓碑；返回是否删除成功
+    bool erase(const std::string& id) {
+        if (migrating()) {
+            migrateStep();
+        }
+
+        size_t index;
+        SlotArray* where = locate(id, index);
+        if (!where) {
+            return false;
+        }
+
+        where->remove(index);
+        --num_elements;
+        if (where == &table) {
+            ++num_tombstones; // 旧表的墓碑随旧表一起释放，不计入
+        }
+
+        if (!migrating() && (double)num_tombstones / table.size > tombstone_threshold) {
+            startRehash(table.size); // 墓碑堆积，原尺寸重建清理
+        }
+        return true;
+    }
+
+    // 立即搬完渐进扩容中剩余的旧槽位
+    void finishRehash() {
+        while (migrating()) {
+            migrateStep();
+        }
+    }
+
+    // 预留足够的槽位，使存入 n 条数据前不再触发扩容；槽位数按 2 倍增长
+    void reserve(size_t n) {
+        finishRehash();
+        size_t new_size = table.size;
+        while ((double)new_size * load_factor_threshold < n) {
+            new_size *= 2;
+        }
+        if (new_size > table.size) {
+            rehash(new_size);
+        }
+    }
+
+    // 设置一次性重建使用的线程数，默认为硬件线程数
+    void setRehashThreads(size_t threads) {
+        rehash_threads = std::max<size_t>(1, threads);
+    }
+
+    size_t size() const { return num_elements; }
+    bool migrating() const { return old_table.size != 0; }
+
+    // 生成当前统计快照；直方图与内存占用需要遍历整张表，按需调用
+    HashTableStats stats() {
+        HashTableStats snapshot = counters;
+        snapshot.num_elements = num_elements;
+        snapshot.num_tombstones = num_tombstones;
+        snapshot.table_size = table.size;
+        snapshot.load_factor = (double)num_elements / table.size;
+        snapshot.probe_length_histogram.assign(kHistogramBins, 0);
+        snapshot.bytes_used = 0;
+
+        for (const SlotArray* t : { &table, &old_table }) {
+            snapshot.bytes_used += t->size * (sizeof(KeySlot) + sizeof(PersonInfo));
+            for (size_t i = 0; i < t->size; ++i) {
+                if (t->state(i) != SLOT_OCCUPIED) {
+                    continue;
+                }
+                const PersonInfo& person = t->value(i);
+                snapshot.bytes_used += heapBytes(person.name) + heapBytes(person.gender)
+                    + heapBytes(person.birthdate) + heapBytes(person.address) + heapBytes(person.phone);
+
+                // 沿探测序列走到该元素所在槽位，得到查找它需要的探测次数
+                size_t index = t->keys[i].hash % t->size;
+                size_t original_index = index;
+                size_t probe = 1;
+                while (index != i) {
+                    index = (original_index + probe * probe) % t->size;
+                    ++probe;
+                }
+                ++snapshot.probe_length_histogram[(probe < kHistogramBins ? probe : kHistogramBins) - 1];
+            }
+        }
+        return snapshot;
+    }
+
+    // 清零查找计数（扩容计数保留）
+    void resetFindStats() {
+        counters.successful_finds = counters.successful_probes = counters.max_successful_probes = 0;
+        counters.unsuccessful_finds = counters.unsuccessful_probes = counters.max_unsuccessful_probes = 0;
+    }
+
+    // 依次对每个元素调用 visit(id, person)
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (const SlotArray* t : { &old_table, &table }) {
+            for (size_t i = 0; i < t->size; ++i) {
+                if (t->state(i) == SLOT_OCCUPIED) {
+                    visit(std::string(t->keys[i].id, kIdLength), t->value(i));
+                }
+            }
+        }
+    }
+
+    // 将哈希表保存到文件
+    void saveToFile(const std::string& filename) {
+        std::ofstream outfile(filename);
+
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+
+        for (const SlotArray* t : { &old_table, &table }) {
+            for (size_t i = 0; i < t->size; ++i) {
+                if (t->state(i) == SLOT_OCCUPIED) {
+                    const PersonInfo& person = t->value(i);
+                    outfile.write(t->keys[i].id, kIdLength);
+                    outfile << ","
+                        << person.name << ","
+                        << person.gender << ","
+                        << person.birthdate << ","
+                        << person.address << ","
+                        << person.phone << "\n";
+                }
+            }
+        }
+
+        outfile.close();
+        std::cout << "Data saved to file: " << filename << std::endl;
+    }
+
+    // 写出可直接 mmap 的镜像文件（布局见 ImageHeader），供 MappedHashTable::openImage 只读打开；返回是否成功
+    bool saveImage(const std::string& filename) {
+        finishRehash();
+        std::ofstream outfile(filename, std::ios::binary);
+
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return false;
+        }
+
+        ImageHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kImageMagic, sizeof(header.magic));
+        header.version = kImageVersion;
+        header.slot_bytes = sizeof(ImageSlot);
+        header.slot_count = table.size;
+        header.num_elements = num_elements;
+        outfile.write(reinterpret_cast<const char*>(&header), sizeof(header)); // 记录堆大小最后回填
+
+        // 槽位数组，顺带算出每条记录的偏移
+        uint64_t offset = 0;
+        for (size_t i = 0; i < table.size; ++i) {
+            ImageSlot slot;
+            std::memset(&slot, 0, sizeof(slot));
+            slot.key.state = table.state(i);
+            if (table.state(i) == SLOT_OCCUPIED) {
+                slot.key = table.keys[i]; // 空槽与墓碑只写状态，身份证号与哈希值保持为 0
+                slot.record = offset;
+                offset += imageRecordBytes(table.value(i));
+            }
+            outfile.write(reinterpret_cast<const char*>(&slot), sizeof(slot));
+        }
+
+        // 记录堆
+        for (size_t i = 0; i < table.size; ++i) {
+            if (table.state(i) == SLOT_OCCUPIED) {
+                const PersonInfo& person = table.value(i);
+                const std::string* fields[kImageFields] = {
+                    &person.name, &person.gender, &person.birthdate, &person.address, &person.phone };
+                for (const std::string* field : fields) {
+                    uint32_t length = (uint32_t)field->size();
+                    outfile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+                }
+                for (const std::string* field : fields) {
+                    outfile.write(field->data(), field->size());
+                }
+            }
+        }
+
+        header.heap_bytes = offset;
+        outfile.seekp(0);
+        outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outfile.close();
+
+        if (!outfile) {
+            std::cerr << "Failed to write image: " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static uint64_t imageRecordBytes(const PersonInfo& person) {
+        return kImageFields * sizeof(uint32_t) + person.name.size() + person.gender.size()
+            + person.birthdate.size() + person.address.size() + person.phone.size();
+    }
+
+    // 简单的哈希函数，调用方按当前表大小取模
+    static uint32_t hashFunction(const char* id) {
+        unsigned long hashValue = 0;
+        for (size_t i = 0; i < kIdLength; ++i) {
+            hashValue = (hashValue * 31 + id[i]) ^ (hashValue >> 7); // 增加扰动
+        }
+        return (uint32_t)hashValue;
+    }
+
+    // 把身份证号转换为定长键并计算哈希，长度不是 18 位时返回 false
+    static bool makeKey(const std::string& id, KeySlot& key) {
+        if (id.size() != kIdLength) {
+            return false;
+        }
+        std::memcpy(key.id, id.data(), kIdLength);
+        key.state = SLOT_EMPTY;
+        key.reserved = 0;
+        key.hash = hashFunction(key.id);
+        return true;
+    }
+
+    // 先比较缓存的哈希值，相同时再比较 18 字节的身份证号
+    static bool sameKey(const KeySlot& a, const KeySlot& b) {
+        return a.hash == b.hash && std::memcmp(a.id, b.id, kIdLength) == 0;
+    }
+
+    // 在 t 中查找 key，返回槽位下标，不存在时返回 t.size；probes 累加探测过的槽位数
+    size_t probeFind(const SlotArray& t, const KeySlot& key, size_t& probes) const {
+        size_t index = key.hash % t.size;
+        size_t original_index = index;
+        size_t probe = 1;
+
+        while (t.state(index) != SLOT_EMPTY) {
+            if (t.state(index) == SLOT_OCCUPIED && sameKey(t.keys[index], key)) {
+                probes += probe;
+                return index;
+            }
+            index = (original_index + probe * probe) % t.size; // 二次探测，墓碑处继续
+            ++probe;
+        }
+
+        probes += probe;
+        return t.size;
+    }
+
+    // 依次在当前表和旧表中查找 id，返回所在的表并写入槽位下标，不存在时返回 nullptr
+    SlotArray* locate(const std::string& id, size_t& index) {
+        KeySlot key;
+        if (!makeKey(id, key)) {
+            return nullptr;
+        }
+
+        size_t probes = 0;
+        SlotArray* where = &table;
+        index = probeFind(table, key, probes);
+        if (index == table.size && migrating()) {
+            where = &old_table;
+            index = probeFind(old_table, key, probes);
+        }
+        if (index == where->size) {
+            where = nullptr;
+        }
+
+        recordFind(where != nullptr, probes);
+        return where;
+    }
+
+    // 把已知不在表中的元素放到 t 的第一个空槽或墓碑上，使用缓存的哈希值；返回是否复用了墓碑
+    bool place(SlotArray& t, const KeySlot& key, PersonInfo&& person) {
+        size_t index = key.hash % t.size;
+        size_t original_index = index;
+        size_t probe = 1;
+
+        while (t.state(index) == SLOT_OCCUPIED) {
+            index = (original_index + probe * probe) % t.size;
+            ++probe;
+        }
+
+        bool reused = t.state(index) == SLOT_DELETED;
+        t.put(index, key, std::move(person));
+        return reused;
+    }
+
+    void recordFind(bool found, size_t probes) {
+        if (found) {
+            ++counters.successful_finds;
+            counters.successful_probes += probes;
+            counters.max_successful_probes = std::max(counters.max_successful_probes, probes);
+        }
+        else {
+            ++counters.unsuccessful_finds;
+            counters.unsuccessful_probes += probes;
+            counters.max_unsuccessful_probes = std::max(counters.max_unsuccessful_probes, probes);
+        }
+    }
+
+    void recordRehash(double seconds, bool compaction) {
+        ++counters.rehash_count;
+        counters.rehash_seconds += seconds;
+        counters.last_rehash_seconds = seconds;
+
+        if (compaction) {
+            ++counters.compaction_count;
+            std::cout << "Compacted hash table, size: " << table.size << std::endl;
+        }
+        else {
+            std::cout << "Rehashed hash table to size: " << table.size << std::endl;
+        }
+    }
+
+    // 用文件剩余字节数除以前若干行的平均长度估算剩余行数，读完样本后回到原位置
+    static size_t estimateRowCount(std::ifstream& infile) {
+        const size_t kSampleLines = 1000;
+        std::streampos data_start = infile.tellg();
+        infile.seekg(0, std::ios::end);
+        std::streamoff remaining = infile.tellg() - data_start;
+        infile.seekg(data_start);
+
+        std::string line;
+        size_t sampled_lines = 0, sampled_bytes = 0;
+        while (sampled_lines < kSampleLines && std::getline(infile, line)) {
+            ++sampled_lines;
+            sampled_bytes += line.size() + 1;
+        }
+        infile.clear();
+        infile.seekg(data_start);
+
+        if (sampled_bytes == 0) {
+            return 0;
+        }
+        // 多估 5%，避免样本行偏长时最后还要扩容一次
+        return (size_t)((double)remaining / sampled_bytes * sampled_lines * 1.05);
+    }
+
+    // 字符串在堆上额外占用的字节数（短字符串存放在对象内部时为 0）
+    static size_t heapBytes(const std::string& s) {
+        const char* data = s.data();
+        const char* self = reinterpret_cast<const char*>(&s);
+        return (data >= self && data < self + sizeof(s)) ? 0 : s.capacity() + 1;
+    }
+
+    // 开始重建：new_size 大于当前大小时为扩容，等于时只清理墓碑
+    void startRehash(size_t new_size) {
+        if (mode == RehashMode::StopTheWorld) {
+            rehash(new_size);
+            return;
+        }
+
+        // 渐进模式：旧表保留下来，由之后的 insert/erase 分批搬走
+        auto start = std::chrono::steady_clock::now();
+        old_table = std::move(table);
+        table = SlotArray(new_size);
+        migrate_pos = 0;
+        num_tombstones = 0;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        migrate_seconds = elapsed.count();
+    }
+
+    // 搬动旧表中的 kMigrateSlots 个槽位，全部搬完后释放旧表
+    void migrateStep() {
+        auto start = std::chrono::steady_clock::now();
+        size_t end = std::min(migrate_pos + kMigrateSlots, old_table.size);
+
+        for (; migrate_pos < end; ++migrate_pos) {
+            if (old_table.state(migrate_pos) == SLOT_OCCUPIED) {
+                // 搬迁期间 erase 会在新表留下墓碑，被复用时要从计数中减去
+                if (place(table, old_table.keys[migrate_pos], std::move(old_table.value(migrate_pos)))) {
+                    --num_tombstones;
+                }
+                old_table.remove(migrate_pos); // 留下墓碑，旧表中其余元素的探测链不受影响
+            }
+        }
+
+        bool done = migrate_pos == old_table.size;
+        bool compaction = done && old_table.size == table.size;
+        if (done) {
+            old_table = SlotArray();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        migrate_seconds += elapsed.count();
+        if (done) {
+            recordRehash(migrate_seconds, compaction);
+        }
+    }
+
+    // 一次性重建哈希表：new_size 大于当前大小时为扩容，等于时只清理墓碑
+    // 大表按槽位区间分给多个线程，各线程用 CAS 抢占新表中的槽位，元素只移动不复制
+    void rehash(size_t new_size) {
+        auto start = std::chrono::steady_clock::now();
+        SlotArray new_table(new_size);
+        size_t threads = table.size >= kParallelRehashSlots ? rehash_threads : 1;
+
+        if (threads == 1) {
+            for (size_t i = 0; i < table.size; ++i) {
+                if (table.state(i) == SLOT_OCCUPIED) {
+                    place(new_table, table.keys[i], std::move(table.value(i)));
+                }
+            }
+        }
+        else {
+            // 新表每个槽位一个抢占标记，抢到的线程独占写入该槽位
+            std::unique_ptr<std::atomic<unsigned char>[]> claimed(new std::atomic<unsigned char>[new_size]());
+            auto worker = [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (table.state(i) != SLOT_OCCUPIED) {
+                        continue;
+                    }
+                    const KeySlot& key = table.keys[i];
+                    size_t index = key.hash % new_size;
+                    size_t original_index = index;
+                    size_t probe = 1;
+                    unsigned char expected = 0;
+                    while (!claimed[index].compare_exchange_strong(expected, 1, std::memory_order_relaxed)) {
+                        expected = 0;
+                        index = (original_index + probe * probe) % new_size;
+                        ++probe;
+                    }
+                    new_table.construct(index, key, std::move(table.value(i)));
+                }
+            };
+
+            std::vector<std::thread> pool;
+            size_t chunk = (table.size + threads - 1) / threads;
+            for (size_t t = 0; t < threads; ++t) {
+                size_t begin = std::min(t * chunk, table.size);
+                pool.emplace_back(worker, begin, std::min(begin + chunk, table.size));
+            }
+            for (std::thread& thread : pool) {
+                thread.join();
+            }
+            new_table.count = table.count;
+        }
+
+        bool compaction = new_size == table.size;
+        table = std::move(new_table);
+        num_tombstones = 0;
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        recordRehash(elapsed.count(), compaction);
+    }
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include "ExternalHashTable.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// ExternalHashTable::saveImage 写出的镜像文件的只读视图。
+// openImage 只映射文件、校验文件头，不解析也不重建，之后 find 直接在映射的槽位数组上按原表的
+// 哈希与二次探测序列查找，页面在第一次访问时才由系统读入
+class MappedHashTable {
+private:
+    const unsigned char* base;  // 映射起始地址
+    size_t length;              // 映射长度
+    const ImageHeader* header;
+    const ImageSlot* slots;
+    const unsigned char* heap;  // 记录堆
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+public:
+    MappedHashTable() : base(nullptr), length(0), header(nullptr), slots(nullptr), heap(nullptr) {
+#ifdef _WIN32
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#endif
+    }
+
+    ~MappedHashTable() {
+        close();
+    }
+
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+
+    // 只读映射镜像文件；返回是否成功
+    bool openImage(const std::string& filename) {
+        close();
+        if (!mapFile(filename)) {
+            std::cerr << "Failed to map image: " << filename << std::endl;
+            return false;
+        }
+
+        header = reinterpret_cast<const ImageHeader*>(base);
+        if (length < sizeof(ImageHeader)
+            || std::memcmp(header->magic, kImageMagic, sizeof(header->magic)) != 0
+            || header->version != kImageVersion
+            || header->slot_bytes != sizeof(ImageSlot)
+            || header->slot_count == 0
+            || header->slot_count > (length - sizeof(ImageHeader)) / sizeof(ImageSlot)
+            || header->heap_bytes != length - sizeof(ImageHeader) - header->slot_count * sizeof(ImageSlot)) {
+            std::cerr << "Invalid image file: " << filename << std::endl;
+            close();
+            return false;
+        }
+
+        slots = reinterpret_cast<const ImageSlot*>(base + sizeof(ImageHeader));
+        heap = base + sizeof(ImageHeader) + header->slot_count * sizeof(ImageSlot);
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (base) {
+            UnmapViewOfFile(base);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#else
+        if (base) {
+            munmap(const_cast<unsigned char*>(base), length);
+        }
+#endif
+        base = nullptr;
+        length = 0;
+        header = nullptr;
+        slots = nullptr;
+        heap = nullptr;
+    }
+
+    // 查找身份证号对应的个人信息，不存在时返回空的 PersonInfo
+    PersonInfo find(const std::string& id) const {
+        size_t index = locate(id);
+        if (index == slotCount()) {
+            return PersonInfo();
+        }
+
+        // 记录越界说明文件已损坏，按未找到处理
+        uint64_t offset = slots[index].record;
+        uint64_t heap_bytes = header->heap_bytes;
+        if (offset > heap_bytes || heap_bytes - offset < kImageFields * sizeof(uint32_t)) {
+            return PersonInfo();
+        }
+        uint32_t lengths[kImageFields];
+        std::memcpy(lengths, heap + offset, sizeof(lengths));
+        offset += sizeof(lengths);
+
+        std::string fields[kImageFields];
+        for (size_t i = 0; i < kImageFields; ++i) {
+            if (heap_bytes - offset < lengths[i]) {
+                return PersonInfo();
+            }
+            fields[i].assign(reinterpret_cast<const char*>(heap + offset), lengths[i]);
+            offset += lengths[i];
+        }
+        return PersonInfo(fields[0], fields[1], fields[2], fields[3], fields[4]);
+    }
+
+    // 只判断身份证号是否存在，不读取记录堆
+    bool contains(const std::string& id) const {
+        return locate(id) != slotCount();
+    }
+
+    bool isOpen() const { return base != nullptr; }
+    size_t size() const { return header ? (size_t)header->num_elements : 0; }
+    size_t slotCount() const { return header ? (size_t)header->slot_count : 0; }
+
+private:
+    // 与 ExternalHashTable::probeFind 相同的探测序列；返回槽位下标，不存在时返回 slotCount()
+    size_t locate(const std::string& id) const {
+        KeySlot key;
+        if (!header || !ExternalHashTable::makeKey(id, key)) {
+            return slotCount();
+        }
+
+        size_t size = slotCount();
+        size_t index = key.hash % size;
+        size_t original_index = index;
+        size_t probe = 1;
+
+        while (slots[index].key.state != SLOT_EMPTY && probe <= size) {
+            if (slots[index].key.state == SLOT_OCCUPIED && ExternalHashTable::sameKey(slots[index].key, key)) {
+                return index;
+            }
+            index = (original_index + probe * probe) % size;
+            ++probe;
+        }
+        return size;
+    }
+
+    bool mapFile(const std::string& filename) {
+#ifdef _WIN32
+        file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+            return false;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            return false;
+        }
+        base = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        length = (size_t)file_size.QuadPart;
+        return base != nullptr;
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* address = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // 映射建立后文件描述符可以关闭
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        madvise(address, (size_t)st.st_size, MADV_RANDOM); // 哈希查找是随机访问，关闭预读
+        base = static_cast<const unsigned char*>(address);
+        length = (size_t)st.st_size;
+        return true;
+#endif
+    }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+// 前 17 位数字加校验码（0-9 或 X）压缩成一个整数：数字 × 11 + 校验码，再加 1 以便用 0 表示空槽。
+// 格式不对时返回 0
+inline uint64_t packId(const std::string& id) {
+    if (id.size() != 18) {
+        return 0;
+    }
+    uint64_t digits = 0;
+    for (size_t i = 0; i < 17; ++i) {
+        if (id[i] < '0' || id[i] > '9') {
+            return 0;
+        }
+        digits = digits * 10 + (uint64_t)(id[i] - '0');
+    }
+    uint64_t check;
+    if (id[17] >= '0' && id[17] <= '9') {
+        check = (uint64_t)(id[17] - '0');
+    }
+    else if (id[17] == 'X' || id[17] == 'x') {
+        check = 10;
+    }
+    else {
+        return 0;
+    }
+    return digits * 11 + check + 1;
+}
+
+inline std::string unpackId(uint64_t key) {
+    key -= 1;
+    uint64_t check = key % 11;
+    uint64_t digits = key / 11;
+    std::string id(18, '0');
+    id[17] = check == 10 ? 'X' : (char)('0' + check);
+    for (int i = 16; i >= 0; --i) {
+        id[i] = (char)('0' + digits % 10);
+        digits /= 10;
+    }
+    return id;
+}
+
+// 64 位混合函数，压缩后的身份证号低位规律性强，取桶下标前先打散
+inline uint64_t mixKey(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include "PersonInfo.h"
+#include "PackedId.h"
+#include "ExternalHashTable.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// 最小完美哈希（BBHash 式分层构造）：把 n 个互不相同的 64 位键一一映射到 [0, n)。
+// 第 l 层有约 gamma × 剩余键数 个位，每个键按第 l 层的哈希落到一个位上，只有独占一个位的键在这一层定下来，
+// 冲突的键全部进入下一层。查找时逐层计算哈希，第一个为 1 的位在所有层拼接后的位数组中的秩就是键的下标。
+// gamma = 2 时约 3.7 位/键，平均 1.5 次哈希。不在集合中的键也会得到一个下标，调用方需要再核对键
+class MinimalPerfectHash {
+private:
+    static const size_t kMaxLevels = 32;     // 超过这么多层仍冲突的键放进 fallback
+    static const size_t kWordsPerSample = 8; // 每 512 位记录一次累计秩
+
+    double gamma;
+    std::vector<uint64_t> bits;            // 所有层的位数组依次拼接，每层从整字开始
+    std::vector<uint64_t> rank_samples;    // rank_samples[i] 为前 i × 512 位中 1 的个数
+    std::vector<size_t> level_offsets;     // 各层在 bits 中的起始字
+    std::vector<size_t> level_words;       // 各层占用的字数
+    std::vector<std::pair<uint64_t, size_t>> fallback; // 按键排序
+    size_t num_keys;
+
+public:
+    explicit MinimalPerfectHash(double gamma_value = 2.0) : gamma(gamma_value), num_keys(0) {}
+
+    // 对互不相同的 keys 构造
+    void build(const std::vector<uint64_t>& keys) {
+        bits.clear();
+        rank_samples.clear();
+        level_offsets.clear();
+        level_words.clear();
+        fallback.clear();
+        num_keys = keys.size();
+
+        std::vector<uint64_t> remaining(keys);
+        std::vector<uint64_t> collision;
+        for (size_t level = 0; level < kMaxLevels && !remaining.empty(); ++level) {
+            size_t words = ((size_t)(gamma * remaining.size()) + 63) / 64;
+            if (words == 0) {
+                words = 1;
+            }
+            size_t offset = bits.size();
+            bits.resize(offset + words, 0);
+            collision.assign(words, 0);
+            uint64_t* level_bits = &bits[offset];
+
+            for (uint64_t key : remaining) {
+                size_t pos = position(key, level, words);
+                uint64_t mask = 1ULL << (pos & 63);
+                if (level_bits[pos / 64] & mask) {
+                    collision[pos / 64] |= mask;
+                }
+                else {
+                    level_bits[pos / 64] |= mask;
+                }
+            }
+            for (size_t w = 0; w < words; ++w) {
+                level_bits[w] &= ~collision[w];
+            }
+
+            // 留下落在冲突位上的键
+            size_t kept = 0;
+            for (uint64_t key : remaining) {
+                size_t pos = position(key, level, words);
+                if (collision[pos / 64] & (1ULL << (pos & 63))) {
+                    remaining[kept++] = key;
+                }
+            }
+            remaining.resize(kept);
+            level_offsets.push_back(offset);
+            level_words.push_back(words);
+        }
+
+        rank_samples.reserve(bits.size() / kWordsPerSample + 1);
+        uint64_t ones = 0;
+        for (size_t w = 0; w < bits.size(); ++w) {
+            if (w % kWordsPerSample == 0) {
+                rank_samples.push_back(ones);
+            }
+            ones += popcount(bits[w]);
+        }
+
+        std::sort(remaining.begin(), remaining.end());
+        for (uint64_t key : remaining) {
+            fallback.push_back(std::make_pair(key, (size_t)ones++));
+        }
+    }
+
+    // 返回 key 的下标；集合外的键返回任意值，可能等于 size()
+    size_t lookup(uint64_t key) const {
+        for (size_t level = 0; level < level_offsets.size(); ++level) {
+            size_t pos = position(key, level, level_words[level]);
+            size_t word = level_offsets[level] + pos / 64;
+            if (bits[word] & (1ULL << (pos & 63))) {
+                return rank(word, pos & 63);
+            }
+        }
+
+        auto it = std::lower_bound(fallback.begin(), fallback.end(), std::make_pair(key, (size_t)0));
+        return it != fallback.end() && it->first == key ? it->second : num_keys;
+    }
+
+    size_t size() const { return num_keys; }
+    size_t levelCount() const { return level_offsets.size(); }
+    size_t fallbackCount() const { return fallback.size(); }
+
+    // 查找结构占用的总位数（位数组、秩采样与 fallback）
+    size_t bitCount() const {
+        return (bits.size() + rank_samples.size()) * 64 + fallback.size() * sizeof(fallback[0]) * 8;
+    }
+
+private:
+    static size_t position(uint64_t key, size_t level, size_t words) {
+        return (size_t)(mixKey(key + (level + 1) * 0x9e3779b97f4a7c15ULL) % (words * 64));
+    }
+
+    static unsigned popcount(uint64_t word) {
+#ifdef _MSC_VER
+        return (unsigned)__popcnt64(word);
+#else
+        return (unsigned)__builtin_popcountll(word);
+#endif
+    }
+
+    // bits 中第 word 个字第 bit 位之前 1 的个数
+    size_t rank(size_t word, size_t bit) const {
+        size_t sample = word / kWordsPerSample;
+        uint64_t result = rank_samples[sample];
+        for (size_t w = sample * kWordsPerSample; w < word; ++w) {
+            result += popcount(bits[w]);
+        }
+        return (size_t)(result + popcount(bits[word] & ((1ULL << bit) - 1)));
+    }
+};
+
+// 只读快照：用最小完美哈希把身份证号映射到稠密的记录数组，没有空槽也不需要探测。
+// 查找为一次（平均 1.5 次）哈希、一次数组访问，再核对压缩后的身份证号
+class PerfectHashTable {
+private:
+    MinimalPerfectHash mph;
+    std::vector<uint64_t> keys;      // keys[i] 为 records[i] 的压缩身份证号；8 字节一个，核对键只访问这个小数组
+    std::vector<PersonInfo> records;
+
+public:
+    explicit PerfectHashTable(double gamma = 2.0) : mph(gamma) {}
+
+    // 从已加载的哈希表构造快照；之后对原表的修改不会反映到快照中
+    void build(const ExternalHashTable& table) {
+        std::vector<uint64_t> packed;
+        std::vector<const PersonInfo*> people;
+        packed.reserve(table.size());
+        people.reserve(table.size());
+        table.forEach([&](const std::string& id, const PersonInfo& person) {
+            uint64_t key = packId(id);
+            if (key == 0) {
+                std::cerr << "Invalid ID card number: " << id << std::endl;
+                return;
+            }
+            packed.push_back(key);
+            people.push_back(&person);
+        });
+
+        mph.build(packed);
+        keys.assign(packed.size(), 0);
+        records.assign(packed.size(), PersonInfo());
+        for (size_t i = 0; i < packed.size(); ++i) {
+            size_t index = mph.lookup(packed[i]);
+            keys[index] = packed[i];
+            records[index] = *people[i];
+        }
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) const {
+        const PersonInfo* person = search(id);
+        return person ? *person : PersonInfo();
+    }
+
+    // 查找身份证号对应的个人信息，返回快照内指针，不存在时返回 nullptr（不复制数据）
+    const PersonInfo* search(const std::string& id) const {
+        uint64_t key = packId(id);
+        if (key == 0) {
+            return nullptr;
+        }
+        size_t index = mph.lookup(key);
+        return index < keys.size() && keys[index] == key ? &records[index] : nullptr;
+    }
+
+    size_t size() const { return keys.size(); }
+
+    // 键数组、记录数组与哈希函数占用的字节数（不含字符串在堆上的部分）
+    size_t bytesUsed() const {
+        return keys.size() * (sizeof(uint64_t) + sizeof(PersonInfo)) + mph.bitCount() / 8;
+    }
+    const MinimalPerfectHash& hashFunction() const { return mph; }
+};
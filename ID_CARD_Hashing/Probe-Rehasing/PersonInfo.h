@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+// 存储个人信息结构体
+struct PersonInfo {
+    std::string name;
+    std::string gender;
+    std::string birthdate;
+    std::string address;
+    std::string phone;
+
+    PersonInfo(const std::string& n = "", const std::string& g = "", const std::string& b = "", const std::string& a = "", const std::string& p = "")
+        : name(n), gender(g), birthdate(b), address(a), phone(p) {}
+};
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "PersonInfo.h"
+#include "ExternalHashTable.h"
+
+// Robin Hood 哈希表：线性探测，每个槽位记录元素离自己起始槽位的距离。
+// 插入时距离更远的元素抢占距离更近的槽位，使探测长度更均匀；
+// 查找走到距离比当前探测步数还小的槽位即可判定不存在；删除时把后面的元素整体前移（backward shift），不留墓碑。
+// 身份证号与哈希值低 32 位按 ExternalHashTable 的 KeySlot 布局内联存放，比较与扩容都不访问堆内存
+class RobinHoodHashTable {
+private:
+    uint16_t* dist;      // 探测距离 + 1，0 表示空槽
+    KeySlot* keys;       // 定长身份证号与哈希值低 32 位，state 字段不使用
+    PersonInfo* values;  // 原始内存，只有 dist 非 0 的槽位上构造了对象
+    size_t capacity;     // 槽位数，2 的幂
+    size_t num_elements; // 当前已存储的元素个数
+    const double load_factor_threshold; // 负载因子阈值
+
+public:
+    RobinHoodHashTable(size_t size = 1024, double max_load_factor = 0.8)
+        : dist(nullptr), keys(nullptr), values(nullptr), capacity(0), num_elements(0), load_factor_threshold(max_load_factor) {
+        size_t rounded = 16;
+        while (rounded < size) {
+            rounded *= 2;
+        }
+        allocate(rounded);
+    }
+
+    ~RobinHoodHashTable() {
+        release();
+    }
+
+    RobinHoodHashTable(const RobinHoodHashTable&) = delete;
+    RobinHoodHashTable& operator=(const RobinHoodHashTable&) = delete;
+
+    // 从CSV文件加载数据
+    void loadFromFile(const std::string& filename) {
+        std::ifstream infile(filename);
+
+        if (!infile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+
+        std::string line;
+        std::getline(infile, line); // 跳过文件表头
+
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string id, name, gender, birthdate, address, phone;
+
+            std::getline(ss, id, ',');
+            std::getline(ss, name, ',');
+            std::getline(ss, gender, ',');
+            std::getline(ss, birthdate, ',');
+            std::getline(ss, address, ',');
+            std::getline(ss, phone, ',');
+
+            insert(id, name, gender, birthdate, address, phone);
+        }
+    }
+
+    // 插入数据到哈希表，身份证号已存在时覆盖
+    void insert(const std::string& id, const std::string& name, const std::string& gender,
+        const std::string& birthdate, const std::string& address, const std::string& phone) {
+        KeySlot key;
+        if (!makeKey(id, key)) {
+            std::cerr << "Invalid ID card number: " << id << std::endl;
+            return;
+        }
+        size_t index = findIndex(key);
+        if (index != capacity) {
+            values[index] = PersonInfo(name, gender, birthdate, address, phone);
+            return;
+        }
+
+        if ((double)(num_elements + 1) / capacity > load_factor_threshold) {
+            rehash(capacity * 2);
+        }
+
+        place(key, PersonInfo(name, gender, birthdate, address, phone));
+        ++num_elements;
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) {
+        PersonInfo* person = search(id);
+        return person ? *person : PersonInfo();
+    }
+
+    // 查找身份证号对应的个人信息，返回表内指针，不存在时返回 nullptr（不复制数据）
+    PersonInfo* search(const std::string& id) {
+        size_t index = locate(id);
+        return index == capacity ? nullptr : &values[index];
+    }
+
+    // 删除身份证号对应的数据；返回是否删除成功
+    bool erase(const std::string& id) {
+        size_t index = locate(id);
+        if (index == capacity) {
+            return false;
+        }
+
+        // 后面不在自己起始槽位上的元素依次前移一格
+        size_t mask = capacity - 1;
+        values[index].~PersonInfo();
+        size_t next = (index + 1) & mask;
+        while (dist[next] > 1) {
+            keys[index] = keys[next];
+            new (&values[index]) PersonInfo(std::move(values[next]));
+            dist[index] = dist[next] - 1;
+            values[next].~PersonInfo();
+            index = next;
+            next = (next + 1) & mask;
+        }
+        dist[index] = 0;
+        --num_elements;
+        return true;
+    }
+
+    size_t size() const { return num_elements; }
+    size_t slotCount() const { return capacity; }
+
+    // 将哈希表保存到文件
+    void saveToFile(const std::string& filename) {
+        std::ofstream outfile(filename);
+
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+
+        for (size_t i = 0; i < capacity; ++i) {
+            if (dist[i]) {
+                outfile.write(keys[i].id, kIdLength);
+                outfile << ","
+                    << values[i].name << ","
+                    << values[i].gender << ","
+                    << values[i].birthdate << ","
+                    << values[i].address << ","
+                    << values[i].phone << "\n";
+            }
+        }
+
+        outfile.close();
+        std::cout << "Data saved to file: " << filename << std::endl;
+    }
+
+private:
+    // 与 ExternalHashTable 相同的字符串哈希，再做一次 64 位混合，使低位足够随机
+    static uint64_t hashFunction(const char* id) {
+        uint64_t hashValue = 0;
+        for (size_t i = 0; i < kIdLength; ++i) {
+            hashValue = (hashValue * 31 + id[i]) ^ (hashValue >> 7);
+        }
+        hashValue ^= hashValue >> 33;
+        hashValue *= 0xff51afd7ed558ccdULL;
+        hashValue ^= hashValue >> 33;
+        return hashValue;
+    }
+
+    // 把身份证号转换为定长键，只保留哈希值低 32 位（槽位下标只用低位）；长度不是 18 位时返回 false
+    static bool makeKey(const std::string& id, KeySlot& key) {
+        if (id.size() != kIdLength) {
+            return false;
+        }
+        std::memcpy(key.id, id.data(), kIdLength);
+        key.state = SLOT_OCCUPIED;
+        key.reserved = 0;
+        key.hash = (uint32_t)hashFunction(key.id);
+        return true;
+    }
+
+    // 返回 id 所在槽位，不存在时返回 capacity（含身份证号格式不对）
+    size_t locate(const std::string& id) const {
+        KeySlot key;
+        return makeKey(id, key) ? findIndex(key) : capacity;
+    }
+
+    // 返回 key 所在槽位，不存在时返回 capacity
+    size_t findIndex(const KeySlot& key) const {
+        size_t mask = capacity - 1;
+        size_t index = (size_t)key.hash & mask;
+        uint16_t d = 1;
+
+        // 槽位上元素的距离比当前步数小，说明 id 若存在早该出现在前面
+        while (dist[index] >= d) {
+            if (dist[index] == d && keys[index].hash == key.hash
+                && std::memcmp(keys[index].id, key.id, kIdLength) == 0) {
+                return index;
+            }
+            index = (index + 1) & mask;
+            ++d;
+        }
+        return capacity;
+    }
+
+    // 放入一个已知不在表中的元素：遇到比自己距离近的元素就交换，继续为被换出的元素找位置；
+    // 起始槽位取自缓存的哈希值
+    void place(const KeySlot& key, PersonInfo&& person) {
+        size_t mask = capacity - 1;
+        size_t index = (size_t)key.hash & mask;
+        uint16_t d = 1;
+        KeySlot carry_key = key;
+        PersonInfo carry(std::move(person));
+
+        while (dist[index]) {
+            if (dist[index] < d) {
+                std::swap(carry_key, keys[index]);
+                std::swap(carry, values[index]);
+                std::swap(d, dist[index]);
+            }
+            index = (index + 1) & mask;
+            ++d;
+        }
+
+        keys[index] = carry_key;
+        new (&values[index]) PersonInfo(std::move(carry));
+        dist[index] = d;
+    }
+
+    void allocate(size_t new_capacity) {
+        dist = static_cast<uint16_t*>(std::calloc(new_capacity, sizeof(uint16_t)));
+        keys = static_cast<KeySlot*>(std::malloc(new_capacity * sizeof(KeySlot)));
+        values = static_cast<PersonInfo*>(std::malloc(new_capacity * sizeof(PersonInfo)));
+        if (!dist || !keys || !values) {
+            std::free(dist);
+            std::free(keys);
+            std::free(values);
+            throw std::bad_alloc();
+        }
+        capacity = new_capacity;
+    }
+
+    void release() {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (dist[i]) {
+                values[i].~PersonInfo();
+            }
+        }
+        std::free(dist);
+        std::free(keys);
+        std::free(values);
+        dist = nullptr;
+        keys = nullptr;
+        values = nullptr;
+    }
+
+    // 扩容到 new_capacity 个槽位，元素整体搬动，不重新计算哈希
+    void rehash(size_t new_capacity) {
+        uint16_t* old_dist = dist;
+        KeySlot* old_keys = keys;
+        PersonInfo* old_values = values;
+        size_t old_capacity = capacity;
+        allocate(new_capacity);
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_dist[i]) {
+                place(old_keys[i], std::move(old_values[i]));
+                old_values[i].~PersonInfo();
+            }
+        }
+
+        std::free(old_dist);
+        std::free(old_keys);
+        std::free(old_values);
+    }
+};
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "PersonInfo.h"
+#include "ExternalHashTable.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_USE_SSE2 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// 分组探测哈希表（Swiss table）：每个槽位一个控制字节，
+// 空槽为 kEmpty、墓碑为 kDeleted、有数据时存哈希值的低 7 位指纹。
+// 控制字节按 16 个一组用 SSE2 一次比较，只有指纹相同的槽位才比较完整的身份证号。
+// 身份证号与哈希值低 32 位按 ExternalHashTable 的 KeySlot 布局内联存放，比较与扩容都不访问堆内存
+class SwissHashTable {
+private:
+    static const size_t kGroupWidth = 16;
+    static const signed char kEmpty = -128;  // 0b10000000
+    static const signed char kDeleted = -2;  // 0b11111110
+
+    signed char* ctrl;   // 控制字节，长度为 capacity
+    KeySlot* keys;       // 定长身份证号与哈希值低 32 位，state 字段不使用
+    PersonInfo* values;  // 原始内存，只有控制字节 >= 0 的槽位上构造了对象
+    size_t capacity;     // 槽位数，kGroupWidth 的 2 的幂倍
+    size_t num_elements; // 当前已存储的元素个数
+    size_t num_deleted;  // 当前墓碑个数
+
+public:
+    SwissHashTable(size_t size = 1024)
+        : ctrl(nullptr), keys(nullptr), values(nullptr), capacity(0), num_elements(0), num_deleted(0) {
+        size_t rounded = kGroupWidth;
+        while (rounded < size) {
+            rounded *= 2;
+        }
+        allocate(rounded);
+    }
+
+    ~SwissHashTable() {
+        release();
+    }
+
+    SwissHashTable(const SwissHashTable&) = delete;
+    SwissHashTable& operator=(const SwissHashTable&) = delete;
+
+    // 从CSV文件加载数据
+    void loadFromFile(const std::string& filename) {
+        std::ifstream infile(filename);
+
+        if (!infile.is_open()) {
+            std::cerr << "Failed to open file: " << filename << std::endl;
+            return;
+        }
+
+        std::string line;
+        std::getline(infile, line); // 跳过文件表头
+
+        while (std::getline(infile, line)) {
+            std::stringstream ss(line);
+            std::string id, name, gender, birthdate, address, phone;
+
+            std::getline(ss, id, ',');
+            std::getline(ss, name, ',');
+            std::getline(ss, gender, ',');
+            std::getline(ss, birthdate, ',');
+            std::getline(ss, address, ',');
+            std::getline(ss, phone, ',');
+
+            insert(id, name, gender, birthdate, address, phone);
+        }
+    }
+
+    // 插入数据到哈希表，身份证号已存在时覆盖
+    void insert(const std::string& id, const std::string& name, const std::string& gender,
+        const std::string& birthdate, const std::string& address, const std::string& phone) {
+        KeySlot key;
+        uint64_t hashValue;
+        if (!makeKey(id, key, hashValue)) {
+            std::cerr << "Invalid ID card number: " << id << std::endl;
+            return;
+        }
+        size_t index = findIndex(key, fingerprint(hashValue));
+        if (index != capacity) {
+            values[index] = PersonInfo(name, gender, birthdate, address, phone);
+            return;
+        }
+
+        // 元素与墓碑合计不超过 7/8
+        if ((num_elements + num_deleted + 1) * 8 > capacity * 7) {
+            rehash(num_elements * 16 > capacity * 7 ? capacity * 2 : capacity);
+        }
+
+        index = findInsertIndex(key.hash);
+        if (ctrl[index] == kDeleted) {
+            --num_deleted;
+        }
+        keys[index] = key;
+        new (&values[index]) PersonInfo(name, gender, birthdate, address, phone);
+        ctrl[index] = fingerprint(hashValue);
+        ++num_elements;
+    }
+
+    // 查找身份证号对应的个人信息
+    PersonInfo find(const std::string& id) {
+        PersonInfo* person = search(id);
+        return person ? *person : PersonInfo();
+    }
+
+    // 查找身份证号对应的个人信息，返回表内指针，不存在时返回 nullptr（不复制数据）
+    PersonInfo* search(const std::string& id) {
+        size_t index = locate(id);
+        return index == capacity ? nullptr : &values[index];
+    }
+
+    // 删除身份证号对应的数据；返回是否删除成功
+    bool erase(const std::string& id) {
+        size_t index = locate(id);
+        if (index == capacity) {
+            return false;
+        }
+
+        values[index].~PersonInfo();
+        --num_elements;
+
+        // 组内还有空槽时，任何探测都会在本组结束，可以直接置空；否则留下墓碑
+        if (matchEmpty(index & ~(kGroupWidth - 1))) {
+            ctrl[index] = kEmpty;
+        }
+        else {
+            ctrl[index] = kDeleted;
+            ++num_deleted;
+        }
+        return true;
+    }
+
+    size_t size() const { return num_elements; }
+    size_t slotCount() const { return capacity; }
+
+    // 将哈希表保存到文件
+    void saveToFile(const std::string& filename) {
+        std::ofstream outfile(filename);
+
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << filename << std::endl;
+            return;
+        }
+
+        outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                outfile.write(keys[i].id, kIdLength);
+                outfile << ","
+                    << values[i].name << ","
+                    << values[i].gender << ","
+                    << values[i].birthdate << ","
+                    << values[i].address << ","
+                    << values[i].phone << "\n";
+            }
+        }
+
+        outfile.close();
+        std::cout << "Data saved to file: " << filename << std::endl;
+    }
+
+private:
+    // 与 ExternalHashTable 相同的字符串哈希，再做一次 64 位混合，
+    // 使高 7 位（指纹）与低位（分组下标）都足够随机
+    static uint64_t hashFunction(const char* id) {
+        uint64_t hashValue = 0;
+        for (size_t i = 0; i < kIdLength; ++i) {
+            hashValue = (hashValue * 31 + id[i]) ^ (hashValue >> 7);
+        }
+        hashValue ^= hashValue >> 33;
+        hashValue *= 0xff51afd7ed558ccdULL;
+        hashValue ^= hashValue >> 33;
+        return hashValue;
+    }
+
+    // 把身份证号转换为定长键，hashValue 为完整的 64 位哈希；长度不是 18 位时返回 false
+    static bool makeKey(const std::string& id, KeySlot& key, uint64_t& hashValue) {
+        if (id.size() != kIdLength) {
+            return false;
+        }
+        std::memcpy(key.id, id.data(), kIdLength);
+        key.state = SLOT_OCCUPIED;
+        key.reserved = 0;
+        hashValue = hashFunction(key.id);
+        key.hash = (uint32_t)hashValue; // 分组下标只用低位，扩容时不必重新计算
+        return true;
+    }
+
+    static signed char fingerprint(uint64_t hashValue) {
+        return (signed char)(hashValue >> 57);
+    }
+
+    size_t groupMask() const {
+        return capacity / kGroupWidth - 1;
+    }
+
+    static unsigned countTrailingZeros(unsigned mask) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return (unsigned)index;
+#else
+        return (unsigned)__builtin_ctz(mask);
+#endif
+    }
+
+    // 以下三个函数返回一组 16 个控制字节的匹配位图，第 i 位对应组内第 i 个槽位
+    unsigned matchFingerprint(size_t group_start, signed char h2) const {
+#ifdef SWISS_USE_SSE2
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + group_start));
+        return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= (unsigned)(ctrl[group_start + i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    unsigned matchEmpty(size_t group_start) const {
+        return matchFingerprint(group_start, kEmpty);
+    }
+
+    // 空槽与墓碑的最高位都是 1
+    unsigned matchEmptyOrDeleted(size_t group_start) const {
+#ifdef SWISS_USE_SSE2
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl + group_start));
+        return (unsigned)_mm_movemask_epi8(group);
+#else
+        unsigned mask = 0;
+        for (size_t i = 0; i < kGroupWidth; ++i) {
+            mask |= (unsigned)(ctrl[group_start + i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // 返回 id 所在槽位，不存在时返回 capacity（含身份证号格式不对）
+    size_t locate(const std::string& id) const {
+        KeySlot key;
+        uint64_t hashValue;
+        return makeKey(id, key, hashValue) ? findIndex(key, fingerprint(hashValue)) : capacity;
+    }
+
+    // 返回 key 所在槽位，不存在时返回 capacity；按组做三角数探测，遇到有空槽的组即停止
+    size_t findIndex(const KeySlot& key, signed char h2) const {
+        size_t group = (size_t)key.hash & groupMask();
+
+        for (size_t step = 1; ; ++step) {
+            size_t group_start = group * kGroupWidth;
+            for (unsigned mask = matchFingerprint(group_start, h2); mask; mask &= mask - 1) {
+                size_t index = group_start + countTrailingZeros(mask);
+                if (keys[index].hash == key.hash && std::memcmp(keys[index].id, key.id, kIdLength) == 0) {
+                    return index;
+                }
+            }
+            if (matchEmpty(group_start)) {
+                return capacity;
+            }
+            group = (group + step) & groupMask();
+        }
+    }
+
+    // 沿同样的探测序列找第一个空槽或墓碑
+    size_t findInsertIndex(uint32_t hash) const {
+        size_t group = (size_t)hash & groupMask();
+
+        for (size_t step = 1; ; ++step) {
+            size_t group_start = group * kGroupWidth;
+            unsigned mask = matchEmptyOrDeleted(group_start);
+            if (mask) {
+                return group_start + countTrailingZeros(mask);
+            }
+            group = (group + step) & groupMask();
+        }
+    }
+
+    void allocate(size_t new_capacity) {
+        ctrl = static_cast<signed char*>(std::malloc(new_capacity));
+        keys = static_cast<KeySlot*>(std::malloc(new_capacity * sizeof(KeySlot)));
+        values = static_cast<PersonInfo*>(std::malloc(new_capacity * sizeof(PersonInfo)));
+        if (!ctrl || !keys || !values) {
+            std::free(ctrl);
+            std::free(keys);
+            std::free(values);
+            throw std::bad_alloc();
+        }
+        std::memset(ctrl, kEmpty, new_capacity);
+        capacity = new_capacity;
+        num_deleted = 0;
+    }
+
+    void release() {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                values[i].~PersonInfo();
+            }
+        }
+        std::free(ctrl);
+        std::free(keys);
+        std::free(values);
+        ctrl = nullptr;
+        keys = nullptr;
+        values = nullptr;
+    }
+
+    // 重建到 new_capacity 个槽位（等于当前大小时只清理墓碑），元素整体搬动；
+    // 分组下标取自缓存的哈希值，指纹沿用旧控制字节，不重新计算哈希
+    void rehash(size_t new_capacity) {
+        signed char* old_ctrl = ctrl;
+        KeySlot* old_keys = keys;
+        PersonInfo* old_values = values;
+        size_t old_capacity = capacity;
+        allocate(new_capacity);
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                size_t index = findInsertIndex(old_keys[i].hash);
+                keys[index] = old_keys[i];
+                new (&values[index]) PersonInfo(std::move(old_values[i]));
+                ctrl[index] = old_ctrl[i];
+                old_values[i].~PersonInfo();
+            }
+        }
+
+        std::free(old_ctrl);
+        std::free(old_keys);
+        std::free(old_values);
+    }
+};
@@ -0,0 +1,607 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <thread>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "ExternalHashTable.h"
+#include "SwissHashTable.h"
+#include "RobinHoodHashTable.h"
+#include "CuckooHashTable.h"
+#include "ConcurrentHashTable.h"
+#include "MappedHashTable.h"
+#include "PerfectHashTable.h"
+
+using namespace std;
+
+// 生成随机身份证号（17 位随机数字 + 校验码，与 Data.py 相同）
+vector<string> generateIds(size_t count, unsigned seed) {
+    static const int weight[17] = { 7, 9, 10, 5, 8, 4, 2, 1, 6, 3, 7, 9, 10, 5, 8, 4, 2 };
+    static const char check_code_map[] = "10X98765432";
+
+    mt19937_64 rng(seed);
+    vector<string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        string id(18, '0');
+        int total = 0;
+        id[0] = char('1' + rng() % 9);
+        for (int j = 1; j < 17; ++j) {
+            id[j] = char('0' + rng() % 10);
+        }
+        for (int j = 0; j < 17; ++j) {
+            total += (id[j] - '0') * weight[j];
+        }
+        id[17] = check_code_map[total % 11];
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+template <typename Table>
+void insertPerson(Table& hashTable, const string& id) {
+    hashTable.insert(id, "张三", "Male", "2000-01-01", "广州", "13800000000");
+}
+
+// 持续删除/插入：每轮删掉 churn 条旧数据再插入同样多的新数据，观察探测长度是否稳定
+void benchChurn(size_t count, size_t rounds) {
+    size_t churn = count / 10;
+    vector<string> ids = generateIds(count + churn * (rounds + 1), 1);
+    vector<string> misses = generateIds(churn, 2);
+
+    ExternalHashTable hashTable;
+    for (size_t i = 0; i < count; ++i) {
+        insertPerson(hashTable, ids[i]);
+    }
+
+    printf("round  elements  tombstones  table_size  hit_avg  hit_max  miss_avg  miss_max  compactions  round_s\n");
+    size_t oldest = 0;      // ids[oldest, next) 为当前表中的数据
+    size_t next = count;
+    for (size_t round = 0; round <= rounds; ++round) {
+        auto start = chrono::steady_clock::now();
+        if (round > 0) {
+            for (size_t i = 0; i < churn; ++i) {
+                hashTable.erase(ids[oldest++]);
+                insertPerson(hashTable, ids[next++]);
+            }
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        hashTable.resetFindStats();
+        for (size_t i = oldest; i < next; i += 7) {
+            hashTable.find(ids[i]);
+        }
+        for (const string& id : misses) {
+            hashTable.find(id);
+        }
+
+        HashTableStats stats = hashTable.stats();
+        printf("%5zu  %8zu  %10zu  %10zu  %7.2f  %7zu  %8.2f  %8zu  %11zu  %7.3f\n",
+            round, stats.num_elements, stats.num_tombstones, stats.table_size,
+            stats.averageSuccessfulProbes(), stats.max_successful_probes,
+            stats.averageUnsuccessfulProbes(), stats.max_unsuccessful_probes,
+            stats.compaction_count, elapsed.count());
+    }
+}
+
+// 返回已排序样本的 p 分位数
+long long percentile(const vector<long long>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return sorted[(size_t)(p * (sorted.size() - 1))];
+}
+
+// 逐条插入并记录耗时，输出按 2 的幂分格的延迟直方图与 p99.9/max
+void benchInsertLatency(RehashMode mode, const vector<string>& ids) {
+    ExternalHashTable hashTable(1024, mode);
+    vector<long long> latencies(ids.size());
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto insert_start = chrono::steady_clock::now();
+        insertPerson(hashTable, ids[i]);
+        auto insert_end = chrono::steady_clock::now();
+        latencies[i] = chrono::duration_cast<chrono::nanoseconds>(insert_end - insert_start).count();
+    }
+    chrono::duration<double> total = chrono::steady_clock::now() - start;
+
+    vector<size_t> histogram(64, 0);
+    for (long long ns : latencies) {
+        size_t bin = 0;
+        while (((long long)1 << (bin + 1)) <= ns) {
+            ++bin;
+        }
+        ++histogram[bin];
+    }
+    sort(latencies.begin(), latencies.end());
+
+    HashTableStats stats = hashTable.stats();
+    printf("[%s] %zu inserts in %.3f s, rehashes %zu (%.3f s total)\n",
+        mode == RehashMode::Incremental ? "incremental" : "stop-the-world",
+        ids.size(), total.count(), stats.rehash_count, stats.rehash_seconds);
+    printf("  p50 %lld ns, p99 %lld ns, p99.9 %lld ns, p99.99 %lld ns, max %lld ns\n",
+        percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 0.999),
+        percentile(latencies, 0.9999), latencies.back());
+    for (size_t bin = 0; bin < histogram.size(); ++bin) {
+        if (histogram[bin]) {
+            printf("  [%10lld, %10lld) ns %10zu\n", (long long)1 << bin, (long long)1 << (bin + 1), histogram[bin]);
+        }
+    }
+
+    // 校验：抽查一部分数据能否查到
+    for (size_t i = 0; i < ids.size(); i += 997) {
+        if (hashTable.find(ids[i]).name.empty()) {
+            cerr << "Lookup failed for " << ids[i] << endl;
+        }
+    }
+}
+
+// 对 ids 逐个调用 search，返回每秒查找次数（百万次）
+template <typename Table>
+double lookupThroughput(Table& hashTable, const vector<string>& ids, size_t& found) {
+    found = 0;
+    auto start = chrono::steady_clock::now();
+    for (const string& id : ids) {
+        found += hashTable.search(id) != nullptr;
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return ids.size() / elapsed.count() / 1e6;
+}
+
+// 两种表都预先设为 2 的幂个槽位，装入 7/8 的数据（负载因子 0.875），比较命中与未命中的查找吞吐
+void benchSwiss(size_t count) {
+    size_t slots = 1024;
+    while (slots * 7 / 8 < count) {
+        slots *= 2;
+    }
+    count = slots * 7 / 8;
+
+    vector<string> ids = generateIds(count, 1);
+    vector<string> misses = generateIds(count, 2);
+    vector<string> hits = ids;
+    shuffle(hits.begin(), hits.end(), mt19937_64(3));
+
+    ExternalHashTable quadratic(slots, RehashMode::StopTheWorld, 0.875);
+    SwissHashTable swiss(slots);
+    for (const string& id : ids) {
+        insertPerson(quadratic, id);
+        insertPerson(swiss, id);
+    }
+
+    printf("%zu slots, %zu keys, load factor %.3f\n", slots, count, (double)count / slots);
+    printf("table        hit Mops/s   miss Mops/s\n");
+    size_t found_hit, found_miss;
+    double hit = lookupThroughput(quadratic, hits, found_hit);
+    double miss = lookupThroughput(quadratic, misses, found_miss);
+    printf("quadratic    %10.2f   %11.2f   (found %zu / %zu)\n", hit, miss, found_hit, found_miss);
+    hit = lookupThroughput(swiss, hits, found_hit);
+    miss = lookupThroughput(swiss, misses, found_miss);
+    printf("swiss        %10.2f   %11.2f   (found %zu / %zu)\n", hit, miss, found_hit, found_miss);
+}
+
+// 逐次计时 search，输出平均值、标准差与分位数
+template <typename Table>
+void printLookupLatency(const char* label, Table& hashTable, const vector<string>& ids) {
+    vector<long long> latencies(ids.size());
+    size_t found = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto start = chrono::steady_clock::now();
+        found += hashTable.search(ids[i]) != nullptr;
+        auto end = chrono::steady_clock::now();
+        latencies[i] = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+    }
+
+    double mean = 0, variance = 0;
+    for (long long ns : latencies) {
+        mean += ns;
+    }
+    mean /= latencies.size();
+    for (long long ns : latencies) {
+        variance += (ns - mean) * (ns - mean);
+    }
+    variance /= latencies.size();
+    sort(latencies.begin(), latencies.end());
+
+    printf("%-16s %8.1f %8.1f %8lld %8lld %9lld %10lld %10lld   (found %zu)\n", label, mean, sqrt(variance),
+        percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 0.999),
+        percentile(latencies, 0.9999), latencies.back(), found);
+}
+
+// 两种表都装到负载因子接近 0.8，比较命中与未命中查找的延迟分布
+void benchRobinHood(size_t count) {
+    size_t slots = 1024;
+    while (slots * 79 / 100 < count) {
+        slots *= 2;
+    }
+    count = slots * 79 / 100;
+
+    vector<string> ids = generateIds(count, 1);
+    vector<string> misses = generateIds(count, 2);
+    vector<string> hits = ids;
+    shuffle(hits.begin(), hits.end(), mt19937_64(3));
+
+    ExternalHashTable quadratic(slots);
+    RobinHoodHashTable robinHood(slots);
+    for (const string& id : ids) {
+        insertPerson(quadratic, id);
+        insertPerson(robinHood, id);
+    }
+
+    printf("%zu slots, %zu keys, load factor %.3f\n", slots, count, (double)count / slots);
+    printf("                 mean(ns)   stddev  p50(ns)  p99(ns) p99.9(ns) p99.99(ns)    max(ns)\n");
+    printLookupLatency("quadratic hit", quadratic, hits);
+    printLookupLatency("quadratic miss", quadratic, misses);
+    printLookupLatency("robin-hood hit", robinHood, hits);
+    printLookupLatency("robin-hood miss", robinHood, misses);
+}
+
+// 两种表预设同样的槽位数并装到负载因子接近 0.8，比较查找延迟的尾部（p99.99 与最大值）
+void benchCuckoo(size_t count) {
+    size_t slots = 1024;
+    while (slots * 79 / 100 < count) {
+        slots *= 2;
+    }
+    count = slots * 79 / 100;
+
+    vector<string> ids = generateIds(count, 1);
+    vector<string> misses = generateIds(count, 2);
+    vector<string> hits = ids;
+    shuffle(hits.begin(), hits.end(), mt19937_64(3));
+
+    ExternalHashTable quadratic(slots);
+    CuckooHashTable cuckoo(slots);
+    for (const string& id : ids) {
+        insertPerson(quadratic, id);
+        insertPerson(cuckoo, id);
+    }
+
+    printf("%zu slots, %zu keys, load factor %.3f, cuckoo slots %zu, stash %zu\n", slots, count,
+        (double)count / slots, cuckoo.slotCount(), cuckoo.stashSize());
+    printf("                 mean(ns)   stddev  p50(ns)  p99(ns) p99.9(ns) p99.99(ns)    max(ns)\n");
+    printLookupLatency("quadratic hit", quadratic, hits);
+    printLookupLatency("quadratic miss", quadratic, misses);
+    printLookupLatency("cuckoo hit", cuckoo, hits);
+    printLookupLatency("cuckoo miss", cuckoo, misses);
+}
+
+// 槽位布局：输出每槽位字节数，建表并记录最后一次扩容耗时，再测平均查找延迟
+void benchLayout(size_t count) {
+    vector<string> ids = generateIds(count, 1);
+    vector<string> misses = generateIds(count, 2);
+
+    ExternalHashTable hashTable;
+    auto start = chrono::steady_clock::now();
+    for (const string& id : ids) {
+        insertPerson(hashTable, id);
+    }
+    chrono::duration<double> build = chrono::steady_clock::now() - start;
+    HashTableStats stats = hashTable.stats();
+
+    printf("slot bytes: KeySlot %zu + PersonInfo %zu = %zu\n",
+        sizeof(KeySlot), sizeof(PersonInfo), sizeof(KeySlot) + sizeof(PersonInfo));
+    printf("%zu entries, %zu slots, build %.3f s, last rehash %.3f s (%zu entries moved)\n",
+        count, stats.table_size, build.count(), stats.last_rehash_seconds,
+        (size_t)(stats.table_size / 2 * 0.8));
+
+    shuffle(ids.begin(), ids.end(), mt19937_64(3));
+    size_t found_hit, found_miss;
+    double hit = lookupThroughput(hashTable, ids, found_hit);
+    double miss = lookupThroughput(hashTable, misses, found_miss);
+    printf("lookup hit %.1f ns, miss %.1f ns (found %zu / %zu)\n", 1e3 / hit, 1e3 / miss, found_hit, found_miss);
+}
+
+// 生成 CSV 测试文件
+void writeCsv(const string& filename, const vector<string>& ids) {
+    ofstream outfile(filename);
+    outfile << "ID,Name,Gender,Birthdate,Address,Phone\n";
+    for (const string& id : ids) {
+        outfile << id << ",张三,Male,2000-01-01,广州市天河区五山路381号,13800000000\n";
+    }
+}
+
+// 分别在不预留与按文件大小预留容量的情况下加载同一个 CSV 文件
+void benchLoad(size_t count) {
+    const string filename = "bench_person_info.csv";
+    writeCsv(filename, generateIds(count, 1));
+
+    for (bool presize : { false, true }) {
+        ExternalHashTable hashTable;
+        auto start = chrono::steady_clock::now();
+        hashTable.loadFromFile(filename, presize);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        HashTableStats stats = hashTable.stats();
+        printf("[%s] loaded %zu rows in %.3f s, rehashes %zu (%.3f s)\n",
+            presize ? "presized" : "no-presize", hashTable.size(), elapsed.count(),
+            stats.rehash_count, stats.rehash_seconds);
+    }
+
+    remove(filename.c_str());
+}
+
+// 把文件从系统页缓存中清出，使下一次打开接近冷启动。
+// Windows 没有按文件清出页缓存的接口，这里什么也不做，image 测试在 Windows 上测到的是热缓存下的耗时
+void dropFileCache(const string& filename) {
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#else
+    (void)filename;
+#endif
+}
+
+// 对 ids 逐个调用 find（复制出个人信息），返回每秒查找次数（百万次）
+template <typename Table>
+double findThroughput(Table& hashTable, const vector<string>& ids) {
+    size_t found = 0;
+    auto start = chrono::steady_clock::now();
+    for (const string& id : ids) {
+        found += !hashTable.find(id).name.empty();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    if (found != ids.size()) {
+        cerr << "Lookup failed: found " << found << " / " << ids.size() << endl;
+    }
+    return ids.size() / elapsed.count() / 1e6;
+}
+
+// 启动耗时：从 CSV 加载建表 vs 打开镜像文件，两者都先清出页缓存，再各自计时第一次查找
+void benchImage(size_t count) {
+    const string csv = "bench_person_info.csv";
+    const string image = "bench_person_info.img";
+    vector<string> ids = generateIds(count, 1);
+    writeCsv(csv, ids);
+    vector<string> queries(ids.begin(), ids.begin() + min<size_t>(ids.size(), 1000000));
+    shuffle(queries.begin(), queries.end(), mt19937_64(3));
+
+    double table_mops;
+    {
+        dropFileCache(csv);
+        ExternalHashTable hashTable;
+        auto start = chrono::steady_clock::now();
+        hashTable.loadFromFile(csv);
+        chrono::duration<double> load = chrono::steady_clock::now() - start;
+        start = chrono::steady_clock::now();
+        PersonInfo person = hashTable.find(queries[0]);
+        chrono::duration<double> first = chrono::steady_clock::now() - start;
+        printf("[csv]   load %.3f s, first find %.1f us (%s)\n", load.count(), first.count() * 1e6,
+            person.name.empty() ? "missing" : "found");
+
+        start = chrono::steady_clock::now();
+        hashTable.saveImage(image);
+        chrono::duration<double> save = chrono::steady_clock::now() - start;
+        ifstream size_probe(image, ios::binary | ios::ate);
+        printf("[image] saved %.1f MB in %.3f s\n", size_probe.tellg() / 1e6, save.count());
+        table_mops = findThroughput(hashTable, queries);
+    }
+
+    dropFileCache(image);
+    MappedHashTable mapped;
+    auto start = chrono::steady_clock::now();
+    mapped.openImage(image);
+    chrono::duration<double> open_time = chrono::steady_clock::now() - start;
+    start = chrono::steady_clock::now();
+    PersonInfo person = mapped.find(queries[0]);
+    chrono::duration<double> first = chrono::steady_clock::now() - start;
+    printf("[image] open %.1f us, first find %.1f us (%s), %zu rows\n", open_time.count() * 1e6,
+        first.count() * 1e6, person.name.empty() ? "missing" : "found", mapped.size());
+
+    // 冷缓存下的前 1000 次查找，每次都可能触发缺页
+    vector<long long> latencies;
+    for (size_t i = 1; i <= 1000 && i < queries.size(); ++i) {
+        auto query_start = chrono::steady_clock::now();
+        mapped.find(queries[i]);
+        auto query_end = chrono::steady_clock::now();
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(query_end - query_start).count());
+    }
+    sort(latencies.begin(), latencies.end());
+    printf("[image] next 1000 cold finds: p50 %lld ns, p99 %lld ns, max %lld ns\n",
+        percentile(latencies, 0.5), percentile(latencies, 0.99), latencies.back());
+
+    double cold_mops = findThroughput(mapped, queries); // 仍有页面第一次被读入
+    double warm_mops = findThroughput(mapped, queries);
+    printf("find throughput (%zu random ids): table %.2f Mops/s, image first pass %.2f Mops/s, warm %.2f Mops/s\n",
+        queries.size(), table_mops, cold_mops, warm_mops);
+
+    mapped.close();
+    remove(csv.c_str());
+    remove(image.c_str());
+}
+
+// 最小完美哈希：先对 count 个压缩身份证号单独构造并测查找吞吐，
+// 再在 table_count 条数据上比较快照表与二次探测表的查找吞吐
+void benchPerfectHash(size_t count, size_t table_count) {
+    vector<uint64_t> keys;
+    keys.reserve(count);
+    for (unsigned chunk = 0; keys.size() < count; ++chunk) {
+        for (const string& id : generateIds(min<size_t>(1000000, count - keys.size()), 100 + chunk)) {
+            keys.push_back(packId(id));
+        }
+    }
+    sort(keys.begin(), keys.end());
+    keys.erase(unique(keys.begin(), keys.end()), keys.end());
+    shuffle(keys.begin(), keys.end(), mt19937_64(3));
+
+    for (double gamma : { 1.0, 2.0 }) {
+        MinimalPerfectHash mph(gamma);
+        auto start = chrono::steady_clock::now();
+        mph.build(keys);
+        chrono::duration<double> build = chrono::steady_clock::now() - start;
+
+        size_t checksum = 0;
+        start = chrono::steady_clock::now();
+        for (uint64_t key : keys) {
+            checksum += mph.lookup(key);
+        }
+        chrono::duration<double> lookup = chrono::steady_clock::now() - start;
+        printf("[mph gamma %.1f] %zu keys, build %.2f s, %.2f bits/key, %zu levels, %zu fallback, lookup %.2f Mops/s%s\n",
+            gamma, keys.size(), build.count(), (double)mph.bitCount() / keys.size(), mph.levelCount(),
+            mph.fallbackCount(), keys.size() / lookup.count() / 1e6,
+            checksum == keys.size() * (keys.size() - 1) / 2 ? "" : " (index sum mismatch)");
+    }
+    keys.clear();
+    keys.shrink_to_fit();
+
+    vector<string> ids = generateIds(table_count, 1);
+    vector<string> misses = generateIds(table_count, 2);
+    vector<string> hits = ids;
+    shuffle(hits.begin(), hits.end(), mt19937_64(3));
+
+    ExternalHashTable quadratic;
+    for (const string& id : ids) {
+        insertPerson(quadratic, id);
+    }
+    PerfectHashTable snapshot;
+    auto start = chrono::steady_clock::now();
+    snapshot.build(quadratic);
+    chrono::duration<double> build = chrono::steady_clock::now() - start;
+    printf("[snapshot] %zu rows built from the probe table in %.2f s, index %.2f bits/key\n", snapshot.size(),
+        build.count(), (double)snapshot.hashFunction().bitCount() / snapshot.size());
+    printf("bytes per row: quadratic %.1f, perfect %.1f\n",
+        (double)quadratic.stats().bytes_used / quadratic.size(), (double)snapshot.bytesUsed() / snapshot.size());
+
+    printf("table        hit Mops/s   miss Mops/s\n");
+    size_t found_hit, found_miss;
+    double hit = lookupThroughput(quadratic, hits, found_hit);
+    double miss = lookupThroughput(quadratic, misses, found_miss);
+    printf("quadratic    %10.2f   %11.2f   (found %zu / %zu)\n", hit, miss, found_hit, found_miss);
+    hit = lookupThroughput(snapshot, hits, found_hit);
+    miss = lookupThroughput(snapshot, misses, found_miss);
+    printf("perfect      %10.2f   %11.2f   (found %zu / %zu)\n", hit, miss, found_hit, found_miss);
+}
+
+// 同一批数据分别用 1~16 个线程做一次翻倍重建，比较耗时
+void benchParallelRehash(size_t count) {
+    vector<string> ids = generateIds(count, 1);
+
+    printf("threads  table_size  rehash_s\n");
+    for (size_t threads = 1; threads <= 16; threads *= 2) {
+        ExternalHashTable hashTable;
+        hashTable.reserve(count);
+        for (const string& id : ids) {
+            insertPerson(hashTable, id);
+        }
+
+        hashTable.setRehashThreads(threads);
+        size_t slots = hashTable.stats().table_size;
+        hashTable.reserve((size_t)(slots * 0.8) + 1); // 刚好触发一次翻倍
+        HashTableStats stats = hashTable.stats();
+        printf("%7zu  %10zu  %8.3f\n", threads, stats.table_size, stats.last_rehash_seconds);
+
+        for (size_t i = 0; i < ids.size(); i += 997) {
+            if (!hashTable.search(ids[i])) {
+                cerr << "Lookup failed for " << ids[i] << endl;
+            }
+        }
+    }
+}
+
+// 把 ids 平均分给 threads 个线程，每个线程对自己那一段调用 work(begin, end)，返回总耗时（秒）
+template <typename Work>
+double runThreads(size_t threads, size_t count, Work work) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back(work, count * t / threads, count * (t + 1) / threads);
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// 1~64 个线程同时向一张从 1024 个槽位起步的并发表插入（期间多次协作扩容），再同时查找
+void benchConcurrent(size_t count) {
+    vector<string> ids = generateIds(count, 1);
+    vector<string> hits = ids;
+    shuffle(hits.begin(), hits.end(), mt19937_64(3));
+
+    printf("threads  insert Mops/s  lookup Mops/s  resizes     slots\n");
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        ConcurrentHashTable hashTable;
+        double insert_seconds = runThreads(threads, ids.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                insertPerson(hashTable, ids[i]);
+            }
+        });
+
+        atomic<size_t> found(0);
+        double lookup_seconds = runThreads(threads, hits.size(), [&](size_t begin, size_t end) {
+            size_t local = 0;
+            for (size_t i = begin; i < end; ++i) {
+                local += hashTable.search(hits[i]) != nullptr;
+            }
+            found += local;
+        });
+
+        printf("%7zu  %13.2f  %13.2f  %7zu  %8zu\n", threads, ids.size() / insert_seconds / 1e6,
+            hits.size() / lookup_seconds / 1e6, hashTable.resizeCount(), hashTable.slotCount());
+        if (hashTable.size() != ids.size() || found != ids.size()) {
+            cerr << "Size mismatch: " << hashTable.size() << " stored, " << found << " found, "
+                << ids.size() << " expected" << endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "churn";
+    size_t count = argc > 2 ? strtoull(argv[2], nullptr, 10) : 1000000;
+
+    if (mode == "churn") {
+        size_t rounds = argc > 3 ? strtoull(argv[3], nullptr, 10) : 20;
+        benchChurn(count, rounds);
+    }
+    else if (mode == "latency") {
+        vector<string> ids = generateIds(count, 1);
+        benchInsertLatency(RehashMode::StopTheWorld, ids);
+        benchInsertLatency(RehashMode::Incremental, ids);
+    }
+    else if (mode == "swiss") {
+        benchSwiss(count);
+    }
+    else if (mode == "robinhood") {
+        benchRobinHood(count);
+    }
+    else if (mode == "cuckoo") {
+        benchCuckoo(count);
+    }
+    else if (mode == "layout") {
+        benchLayout(count);
+    }
+    else if (mode == "load") {
+        benchLoad(count);
+    }
+    else if (mode == "rehash") {
+        benchParallelRehash(count);
+    }
+    else if (mode == "image") {
+        benchImage(count);
+    }
+    else if (mode == "mph") {
+        size_t table_count = argc > 3 ? strtoull(argv[3], nullptr, 10) : 2000000;
+        benchPerfectHash(count, table_count);
+    }
+    else if (mode == "concurrent") {
+        benchConcurrent(count);
+    }
+    else {
+        cerr << "Unknown benchmark: " << mode << endl;
+        return 1;
+    }
+
+    return 0;
+}
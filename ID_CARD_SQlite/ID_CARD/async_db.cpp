@@ -0,0 +1,113 @@
+#include "async_db.h"
+
+AsyncPersonDb::AsyncPersonDb() : drain_scheduled(false), max_group(1000), commit_count(0), write_count(0) {}
+
+AsyncPersonDb::~AsyncPersonDb() {
+    close();
+}
+
+int AsyncPersonDb::open(const std::string& filename, size_t readers, size_t group_limit) {
+    if (readers == 0) {
+        return SQLITE_MISUSE;  // 没有读线程时 get() 的 future 永远不会就绪
+    }
+    max_group = group_limit > 0 ? group_limit : 1;
+    return pool.open(filename, readers);
+}
+
+void AsyncPersonDb::close() {
+    pool.close();  // drain 任务会处理完所有积压的写请求才返回
+}
+
+std::future<PersonLookup> AsyncPersonDb::get(const std::string& id_card_number) {
+    auto done = std::make_shared<std::promise<PersonLookup>>();
+    std::future<PersonLookup> result = done->get_future();
+    pool.submitRead([done, id_card_number](Connection& conn) {
+        PersonLookup lookup;
+        lookup.found = find_person(conn, id_card_number, lookup.person) == SQLITE_ROW;
+        lookup.person.id_card_number = id_card_number;
+        done->set_value(lookup);
+    });
+    return result;
+}
+
+std::future<int> AsyncPersonDb::insert(const Person& person) {
+    return submitWrite([person](Connection& conn) {
+        return insert_person_info(conn, person.id_card_number, person.name, person.gender, person.birth_date,
+            person.address, person.phone);
+    });
+}
+
+std::future<int> AsyncPersonDb::update(const std::string& id_card_number, const std::string& name, const std::string& phone) {
+    return submitWrite([id_card_number, name, phone](Connection& conn) {
+        return update_person_info(conn, id_card_number, name, phone);
+    });
+}
+
+std::future<int> AsyncPersonDb::remove(const std::string& id_card_number) {
+    return submitWrite([id_card_number](Connection& conn) {
+        return delete_person_info(conn, id_card_number);
+    });
+}
+
+std::future<int> AsyncPersonDb::submitWrite(std::function<int(Connection&)> apply) {
+    WriteRequest request = { std::move(apply), std::make_shared<std::promise<int>>() };
+    std::future<int> result = request.done->get_future();
+    bool schedule;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(request));
+        schedule = !drain_scheduled;
+        drain_scheduled = true;
+    }
+    if (schedule) {
+        pool.submitWrite([this](Connection& conn) { drain(conn); });
+    }
+    return result;
+}
+
+void AsyncPersonDb::drain(Connection& conn) {
+    std::vector<WriteRequest> group;
+    std::vector<int> results;
+    for (;;) {
+        group.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending.empty()) {
+                drain_scheduled = false;
+                return;
+            }
+            // 上一个事务提交期间到达的写请求在这里一起取出
+            while (!pending.empty() && group.size() < max_group) {
+                group.push_back(std::move(pending.front()));
+                pending.pop_front();
+            }
+        }
+
+        // 单条语句失败（如主键冲突）只撤销该语句，事务中的其他写请求照常提交。
+        // 但 SQLITE_FULL、SQLITE_IOERR、SQLITE_NOMEM、中断等错误会回滚整个事务：此时之前的写请求也已撤销，
+        // 后面的写请求不再执行（否则会以自动提交方式真正写入），整组都以该错误码结束
+        results.assign(group.size(), SQLITE_OK);
+        int rc = conn.exec("BEGIN IMMEDIATE;");
+        if (rc == SQLITE_OK) {
+            for (size_t i = 0; i < group.size(); ++i) {
+                results[i] = group[i].apply(conn);
+                if (results[i] != SQLITE_OK && sqlite3_get_autocommit(conn.handle())) {
+                    rc = results[i];
+                    break;
+                }
+            }
+            if (rc == SQLITE_OK) {
+                rc = conn.exec("COMMIT;");
+                if (rc != SQLITE_OK && !sqlite3_get_autocommit(conn.handle())) {
+                    conn.exec("ROLLBACK;");
+                }
+            }
+        }
+        ++commit_count;
+        write_count += group.size();
+
+        for (size_t i = 0; i < group.size(); ++i) {
+            group[i].done->set_value(rc == SQLITE_OK ? results[i] : rc);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <future>
+#include <functional>
+#include "connection_pool.h"
+#include "person_db.h"
+
+// 异步访问 person_info：每个调用立即返回 future，调用方可以同时挂起大量请求。
+// 查询在连接池的读线程上执行；写请求先进入等待队列，由写线程把当前积压的写请求合并成一个事务提交（组提交），
+// 一次提交分摊到多个写请求上。写请求的 future 在事务提交之后才就绪，就绪后发出的查询一定能读到这次写入
+class AsyncPersonDb {
+public:
+    AsyncPersonDb();
+    ~AsyncPersonDb();
+
+    AsyncPersonDb(const AsyncPersonDb&) = delete;
+    AsyncPersonDb& operator=(const AsyncPersonDb&) = delete;
+
+    // 以 WAL 模式打开数据库，readers 个读线程（至少 1 个，为 0 时返回 SQLITE_MISUSE）；
+    // group_limit 为一个事务最多合并的写请求数（1 表示不合并）
+    int open(const std::string& filename, size_t readers, size_t group_limit = 1000);
+
+    // 执行完已提交的请求后关闭
+    void close();
+
+    // 查询；结果的 found 为 false 表示不存在或出错
+    std::future<PersonLookup> get(const std::string& id_card_number);
+
+    // 写请求；future 的值为该请求的 SQLite 结果码（事务提交失败或被某个写请求的错误整体回滚时，为导致失败的结果码）
+    std::future<int> insert(const Person& person);
+    std::future<int> update(const std::string& id_card_number, const std::string& name, const std::string& phone);
+    std::future<int> remove(const std::string& id_card_number);
+
+    // 已提交的事务数与写请求数，两者之比为平均每个事务合并的写请求数
+    uint64_t commits() const { return commit_count.load(); }
+    uint64_t writes() const { return write_count.load(); }
+
+private:
+    struct WriteRequest {
+        std::function<int(Connection&)> apply;
+        std::shared_ptr<std::promise<int>> done;
+    };
+
+    std::future<int> submitWrite(std::function<int(Connection&)> apply);
+
+    // 在写线程上运行：反复取出积压的写请求，合并成一个事务执行，直到队列为空
+    void drain(Connection& conn);
+
+    ConnectionPool pool;
+    std::mutex mutex;
+    std::deque<WriteRequest> pending;  // 等待写线程处理的写请求
+    bool drain_scheduled;              // 写线程上是否已有 drain 任务在排队或运行
+    size_t max_group;
+    std::atomic<uint64_t> commit_count;
+    std::atomic<uint64_t> write_count;
+};
@@ -0,0 +1,898 @@
+#include "bench.h"
+#include "person_db.h"
+#include "connection_pool.h"
+#include "csv_export.h"
+#include "csv_import.h"
+#include "packed_person_db.h"
+#include "person_cache.h"
+#include "async_db.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <future>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// 生成随机身份证号（17 位随机数字 + 校验码，与 Data.py 相同）
+static std::vector<std::string> generate_ids(size_t count, unsigned seed) {
+    static const int weight[17] = { 7, 9, 10, 5, 8, 4, 2, 1, 6, 3, 7, 9, 10, 5, 8, 4, 2 };
+    static const char check_code_map[] = "10X98765432";
+
+    std::mt19937_64 rng(seed);
+    std::vector<std::string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string id(18, '0');
+        int total = 0;
+        id[0] = char('1' + rng() % 9);
+        for (int j = 1; j < 17; ++j) {
+            id[j] = char('0' + rng() % 10);
+        }
+        for (int j = 0; j < 17; ++j) {
+            total += (id[j] - '0') * weight[j];
+        }
+        id[17] = check_code_map[total % 11];
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+// 由身份证号生成一条测试记录，出生日期取身份证号第 7~14 位（与 Data.py 相同）。
+// 姓名取身份证号中的 3 位数字组合（1000 种），电话为 1 加身份证号第 8~17 位，便于测试按姓名、电话查询
+static Person make_person(const std::string& id) {
+    static const char* const surnames[] = { "张", "王", "李", "赵", "刘", "陈", "杨", "黄", "周", "吴" };
+    static const char* const given[] = { "伟", "芳", "娜", "敏", "静", "强", "磊", "洋", "艳", "勇" };
+    Person person;
+    person.id_card_number = id;
+    person.name = std::string(surnames[id[13] - '0']) + given[id[14] - '0'] + given[id[15] - '0'];
+    person.gender = (id[16] - '0') % 2 ? "Male" : "Female";
+    person.birth_date = id.substr(6, 4) + "-" + id.substr(10, 2) + "-" + id.substr(12, 2);
+    person.address = "广东省广州市天河区五山路381号";
+    person.phone = "1" + id.substr(7, 10);
+    return person;
+}
+
+// 为每个身份证号生成一条测试记录
+static std::vector<Person> make_people(const std::vector<std::string>& ids) {
+    std::vector<Person> people;
+    people.reserve(ids.size());
+    for (const std::string& id : ids) {
+        people.push_back(make_person(id));
+    }
+    return people;
+}
+
+// 删除测试数据库及其日志文件
+static void remove_database(const std::string& filename) {
+    for (const char* suffix : { "", "-journal", "-wal", "-shm" }) {
+        std::remove((filename + suffix).c_str());
+    }
+}
+
+// 删除旧的测试数据库并新建表
+static bool open_fresh_database(Connection& conn, const std::string& filename) {
+    remove_database(filename);
+    return conn.open(filename) == SQLITE_OK && create_table(conn) == SQLITE_OK;
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 按身份证号顺序导入 count 行测试数据。顺序插入时主键 B 树只在末尾追加，大表也能较快建好；
+// 导入期间关闭同步，只用于准备测试数据
+static bool populate_sorted(const std::string& filename, size_t count) {
+    Connection conn;
+    if (!open_fresh_database(conn, filename)) {
+        return false;
+    }
+    conn.exec("PRAGMA synchronous = OFF;");
+    std::vector<std::string> ids = generate_ids(count, 1);
+    std::sort(ids.begin(), ids.end());
+
+    const size_t chunk = 100000;
+    for (size_t begin = 0; begin < ids.size(); begin += chunk) {
+        std::vector<std::string> part(ids.begin() + begin, ids.begin() + std::min(ids.size(), begin + chunk));
+        if (insert_person_batch(conn, make_people(part), part.size()) != SQLITE_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 每次调用都 prepare/finalize 的插入（语句缓存之前的写法）
+static int insert_uncached(sqlite3* db, const Person& p) {
+    const char* insert_sql = R"(
+        INSERT INTO person_info (id_card_number, name, gender, birth_date, address, phone)
+        VALUES (?, ?, ?, ?, ?, ?);
+    )";
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db, insert_sql, -1, &stmt, 0);
+    if (rc != SQLITE_OK) {
+        return rc;
+    }
+    sqlite3_bind_text(stmt, 1, p.id_card_number.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, p.name.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, p.gender.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, p.birth_date.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, p.address.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 6, p.phone.c_str(), -1, SQLITE_STATIC);
+    rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    return rc == SQLITE_DONE ? SQLITE_OK : rc;
+}
+
+// 每次调用都 prepare/finalize 的点查（语句缓存之前的写法，去掉了打印）
+static int find_uncached(sqlite3* db, const std::string& id, Person& person) {
+    const char* sql = "SELECT name, gender, birth_date, address, phone FROM person_info WHERE id_card_number = ?;";
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, 0);
+    if (rc != SQLITE_OK) {
+        return rc;
+    }
+    sqlite3_bind_text(stmt, 1, id.c_str(), -1, SQLITE_STATIC);
+    rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        person.name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        person.gender = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        person.birth_date = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+        person.address = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+        person.phone = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
+    }
+    sqlite3_finalize(stmt);
+    return rc;
+}
+
+// sqlite3_exec 回调逐字段经 ofstream 写出的导出（流式导出之前的写法）
+static int export_callback(void* data, int argc, char** argv, char** /*azColName*/) {
+    std::ofstream* csv_file = (std::ofstream*)data;
+    for (int i = 0; i < argc; i++) {
+        *csv_file << (argv[i] ? argv[i] : "NULL");
+        if (i < argc - 1) {
+            *csv_file << ",";
+        }
+    }
+    *csv_file << "\n";
+    return 0;
+}
+
+static int export_exec(Connection& conn, const std::string& filename) {
+    std::ofstream csv_file(filename, std::ios::out | std::ios::binary);
+    unsigned char utf8_bom[3] = { 0xEF, 0xBB, 0xBF };
+    csv_file.write(reinterpret_cast<char*>(utf8_bom), 3);
+    return sqlite3_exec(conn.handle(), "SELECT * FROM person_info", export_callback, &csv_file, nullptr);
+}
+
+// 读取整个文件，用于核对两种导出结果是否一致
+static std::string read_file(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// sqlite3_exec 回调导出与流式缓冲导出的吞吐（MB/s 按输出的 CSV 字节数计算）。
+// 两种方式交替各跑两遍取较快的一次，数据库页面都已在页缓存中
+static void bench_export(size_t count) {
+    const std::string filename = "bench_export.db";
+    if (!populate_sorted(filename, count)) {
+        return;
+    }
+    Connection conn;
+    conn.open(filename);
+
+    double best[2] = { 1e30, 1e30 };
+    size_t bytes = 0;
+    for (int round = 0; round < 2; ++round) {
+        for (int streaming = 0; streaming < 2; ++streaming) {
+            const std::string csv = streaming ? "bench_export_stream.csv" : "bench_export_exec.csv";
+            auto start = std::chrono::steady_clock::now();
+            int rc = streaming ? export_csv(conn, csv, &bytes) : export_exec(conn, csv);
+            double seconds = seconds_since(start);
+            if (rc != SQLITE_OK) {
+                std::cerr << "Export failed" << std::endl;
+                return;
+            }
+            best[streaming] = std::min(best[streaming], seconds);
+        }
+    }
+
+    // 测试数据不含需要加引号的字段，两种方式的输出应逐字节相同
+    bool same = count <= 2000000 ? read_file("bench_export_exec.csv") == read_file("bench_export_stream.csv") : true;
+    for (int streaming = 0; streaming < 2; ++streaming) {
+        printf("[%s] %zu rows, %.1f MB: %.2f s (%.1f MB/s, %.0f rows/s)\n",
+            streaming ? "streaming" : "sqlite3_exec", count, bytes / 1e6, best[streaming],
+            bytes / 1e6 / best[streaming], count / best[streaming]);
+    }
+    printf("output identical: %s\n", count <= 2000000 ? (same ? "yes" : "NO") : "not checked");
+
+    conn.close();
+    std::remove("bench_export_exec.csv");
+    std::remove("bench_export_stream.csv");
+    remove_database(filename);
+}
+
+// 按 rowid 范围并行导出的吞吐：不同线程数下分别测保留分段文件与拼接成单个文件两种方式，并与单线程流式导出对比
+static void bench_parallel_export(size_t count) {
+    const std::string filename = "bench_parallel.db";
+    if (!populate_sorted(filename, count)) {
+        return;
+    }
+
+    size_t bytes = 0;
+    double single = 1e30;
+    for (int round = 0; round < 2; ++round) {
+        Connection conn;
+        conn.open(filename);
+        auto start = std::chrono::steady_clock::now();
+        if (export_csv(conn, "bench_single.csv", &bytes) != SQLITE_OK) {
+            return;
+        }
+        single = std::min(single, seconds_since(start));
+    }
+    printf("%-8s %-8s %10s %10s %10s\n", "threads", "output", "seconds", "MB/s", "speedup");
+    printf("%-8s %-8s %10.2f %10.1f %10.2f\n", "1", "single", single, bytes / 1e6 / single, 1.0);
+
+    std::string expected = count <= 2000000 ? read_file("bench_single.csv") : std::string();
+    bool identical = true;
+    for (size_t threads : { (size_t)1, (size_t)2, (size_t)4, (size_t)8 }) {
+        for (bool keep_parts : { true, false }) {
+            auto start = std::chrono::steady_clock::now();
+            if (export_csv_parallel(filename, "bench_parallel.csv", threads, keep_parts, &bytes) != SQLITE_OK) {
+                std::cerr << "Parallel export failed" << std::endl;
+                return;
+            }
+            double seconds = seconds_since(start);
+            printf("%-8zu %-8s %10.2f %10.1f %10.2f\n", threads, keep_parts ? "parts" : "concat", seconds,
+                bytes / 1e6 / seconds, single / seconds);
+
+            if (keep_parts) {
+                for (size_t i = 0; i < threads; ++i) {
+                    char part[64];
+                    snprintf(part, sizeof(part), "bench_parallel.csv.part%03zu", i);
+                    std::remove(part);
+                }
+            }
+            else if (!expected.empty()) {
+                identical = identical && read_file("bench_parallel.csv") == expected;
+            }
+        }
+    }
+    printf("concatenated output identical to single-threaded export: %s\n",
+        expected.empty() ? "not checked" : identical ? "yes" : "NO");
+
+    std::remove("bench_single.csv");
+    std::remove("bench_parallel.csv");
+    remove_database(filename);
+}
+
+// 生成 count 行随机身份证号的 CSV（带 Data.py 的表头行），逐行写出，不在内存中保留全部记录
+static bool write_test_csv(const std::string& filename, size_t count) {
+    CsvWriter writer;
+    if (!writer.open(filename)) {
+        return false;
+    }
+    const char* header[] = { "id_card_number", "name", "gender", "birth_date", "address", "phone" };
+    for (const char* column : header) {
+        writer.field(column, strlen(column));
+    }
+    writer.endRow();
+
+    const size_t chunk = 1000000;
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        for (const std::string& id : generate_ids(std::min(chunk, count - begin), 1 + (unsigned)(begin / chunk))) {
+            Person p = make_person(id);
+            for (const std::string* value : { &p.id_card_number, &p.name, &p.gender, &p.birth_date, &p.address, &p.phone }) {
+                writer.field(value->data(), value->size());
+            }
+            writer.endRow();
+        }
+    }
+    return writer.close();
+}
+
+// C++ 批量导入 CSV 的速度：随机顺序的身份证号，导入到新建的空表
+static void bench_import(size_t count) {
+    const std::string csv = "bench_import.csv";
+    const std::string filename = "bench_import.db";
+    if (!write_test_csv(csv, count)) {
+        return;
+    }
+
+    Connection conn;
+    if (!open_fresh_database(conn, filename)) {
+        return;
+    }
+    ImportStats stats;
+    if (import_csv(conn, csv, &stats) != SQLITE_OK) {
+        std::cerr << "Import failed" << std::endl;
+    }
+    printf("import %zu rows: %.2f s (%.0f rows/s), ignored %zu, invalid %zu\n", stats.rows, stats.seconds,
+        stats.rows / stats.seconds, stats.ignored, stats.invalid);
+
+    conn.close();
+    std::remove(csv.c_str());
+    remove_database(filename);
+}
+
+static size_t file_size(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    return in ? (size_t)in.tellg() : 0;
+}
+
+// TEXT 主键与压缩整数主键两种表结构的导入耗时、数据库文件大小与点查延迟。
+// 每种表结构分别导入随机顺序与按身份证号排序的相同数据（10 万行一个事务），点查为随机顺序的已存在身份证号
+static void bench_schema(size_t count) {
+    std::vector<std::string> ids = generate_ids(count, 1);
+    std::vector<Person> people = make_people(ids);
+    std::vector<Person> sorted_people = people;
+    std::sort(sorted_people.begin(), sorted_people.end(),
+        [](const Person& a, const Person& b) { return a.id_card_number < b.id_card_number; });  // 压缩后的顺序与字典序相同
+    std::vector<std::string> queries = ids;
+    std::shuffle(queries.begin(), queries.end(), std::mt19937_64(3));
+    queries.resize(std::min(queries.size(), (size_t)200000));
+
+    printf("%-8s %-7s %10s %12s %10s %8s %8s %8s\n", "schema", "input", "import s", "rows/s", "file MB", "avg us", "p50 us", "p99 us");
+    for (bool packed : { false, true }) {
+        for (bool sorted : { false, true }) {
+            const std::string filename = packed ? "bench_packed.db" : "bench_text.db";
+            Connection conn;
+            remove_database(filename);
+            if (conn.open(filename) != SQLITE_OK || (packed ? create_packed_table(conn) : create_table(conn)) != SQLITE_OK) {
+                return;
+            }
+
+            const std::vector<Person>& rows = sorted ? sorted_people : people;
+            double rows_per_second = 0;
+            auto start = std::chrono::steady_clock::now();
+            int rc = packed ? insert_packed_person_batch(conn, rows, 100000, &rows_per_second)
+                            : insert_person_batch(conn, rows, 100000, &rows_per_second);
+            double import_seconds = seconds_since(start);
+            if (rc != SQLITE_OK) {
+                std::cerr << "Import failed" << std::endl;
+                return;
+            }
+
+            std::vector<double> latencies;
+            latencies.reserve(queries.size());
+            Person person;
+            size_t found = 0;
+            for (const std::string& id : queries) {
+                auto t = std::chrono::steady_clock::now();
+                rc = packed ? find_packed_person(conn, id, person) : find_person(conn, id, person);
+                latencies.push_back(seconds_since(t) * 1e6);
+                found += rc == SQLITE_ROW && person.id_card_number == id;
+            }
+            double total = 0;
+            for (double l : latencies) {
+                total += l;
+            }
+            std::sort(latencies.begin(), latencies.end());
+            conn.close();
+
+            printf("%-8s %-7s %10.2f %12.0f %10.1f %8.2f %8.2f %8.2f  (found %zu/%zu)\n", packed ? "packed" : "text",
+                sorted ? "sorted" : "random", import_seconds, rows_per_second, file_size(filename) / 1e6,
+                total / latencies.size(), latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100],
+                found, queries.size());
+            remove_database(filename);
+        }
+    }
+}
+
+// 按 Zipf 分布（第 k 热门的概率正比于 1 / k^s）抽取 count 个下标，范围 [0, n)
+static std::vector<size_t> zipf_indices(size_t n, size_t count, double s, unsigned seed) {
+    std::vector<double> cdf(n);
+    double total = 0;
+    for (size_t k = 0; k < n; ++k) {
+        total += 1.0 / std::pow((double)(k + 1), s);
+        cdf[k] = total;
+    }
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0, total);
+    std::vector<size_t> indices(count);
+    for (size_t& index : indices) {
+        index = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+        index = std::min(index, n - 1);
+    }
+    return indices;
+}
+
+// Zipf 分布的点查下，无缓存与不同容量 LRU 缓存的命中率和平均延迟；最后检查更新后缓存不会返回旧数据
+static void bench_cache(size_t count) {
+    const std::string filename = "bench_cache.db";
+    std::vector<std::string> ids = generate_ids(count, 1);
+    {
+        Connection conn;
+        if (!open_fresh_database(conn, filename) || insert_person_batch(conn, make_people(ids), 100000) != SQLITE_OK) {
+            return;
+        }
+    }
+    std::shuffle(ids.begin(), ids.end(), std::mt19937_64(5));  // 热门程度与插入顺序无关
+
+    Connection conn;
+    conn.open(filename);
+    const size_t lookups = 1000000;
+    printf("%6s %12s %10s %10s %12s\n", "zipf s", "cache rows", "hit rate", "avg us", "lookups/s");
+    for (double s : { 0.8, 0.99, 1.2 }) {
+        std::vector<size_t> workload = zipf_indices(ids.size(), lookups, s, 7);
+        for (size_t capacity : { (size_t)0, count / 1000, count / 100, count / 10 }) {
+            PersonCache cache(capacity == 0 ? 1 : capacity);
+            Person person;
+            size_t found = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t index : workload) {
+                int rc = capacity == 0 ? find_person(conn, ids[index], person)
+                                       : find_person_cached(conn, cache, ids[index], person);
+                found += rc == SQLITE_ROW;
+            }
+            double seconds = seconds_since(start);
+            printf("%6.2f %12s %9.1f%% %10.2f %12.0f\n", s, capacity == 0 ? "uncached" : std::to_string(capacity).c_str(),
+                cache.hitRate() * 100, seconds * 1e6 / lookups, lookups / seconds);
+            if (found != lookups) {
+                std::cerr << "Missing rows: " << lookups - found << std::endl;
+            }
+        }
+    }
+
+    // 缓存一条记录后更新、删除，确认读到的是数据库中的最新状态
+    PersonCache cache(1000);
+    Person person;
+    find_person_cached(conn, cache, ids[0], person);
+    update_person_info_cached(conn, cache, ids[0], "李四", "13900000000");
+    bool updated = find_person_cached(conn, cache, ids[0], person) == SQLITE_ROW && person.name == "李四";
+    delete_person_info_cached(conn, cache, ids[0]);
+    bool deleted = find_person_cached(conn, cache, ids[0], person) == SQLITE_DONE;
+    printf("invalidation: update %s, delete %s\n", updated ? "ok" : "STALE", deleted ? "ok" : "STALE");
+
+    conn.close();
+    remove_database(filename);
+}
+
+// 批量查询与逐个调用 find_person 的每个身份证号耗时；每批 90% 为已存在的身份证号，10% 不存在
+static void bench_multi_get(size_t count) {
+    const std::string filename = "bench_multiget.db";
+    std::vector<std::string> ids = generate_ids(count, 1);
+    {
+        Connection conn;
+        if (!open_fresh_database(conn, filename) || insert_person_batch(conn, make_people(ids), 100000) != SQLITE_OK) {
+            return;
+        }
+    }
+    std::vector<std::string> absent = generate_ids(count / 10 + 1, 2);
+
+    Connection conn;
+    conn.open(filename);
+    std::mt19937_64 rng(9);
+    const size_t total_ids = 1000000;
+    printf("%8s %14s %14s %10s %8s\n", "batch", "loop us/id", "batch us/id", "speedup", "match");
+    for (size_t batch_size : { (size_t)100, (size_t)1000, (size_t)10000 }) {
+        std::vector<std::vector<std::string>> batches(total_ids / batch_size);
+        for (auto& batch : batches) {
+            for (size_t i = 0; i < batch_size; ++i) {
+                batch.push_back(rng() % 10 == 0 ? absent[rng() % absent.size()] : ids[rng() % ids.size()]);
+            }
+        }
+
+        size_t loop_found = 0;
+        Person person;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& batch : batches) {
+            for (const std::string& id : batch) {
+                loop_found += find_person(conn, id, person) == SQLITE_ROW;
+            }
+        }
+        double loop_seconds = seconds_since(start);
+
+        size_t batch_found = 0;
+        bool in_order = true;
+        std::vector<PersonLookup> results;
+        start = std::chrono::steady_clock::now();
+        for (const auto& batch : batches) {
+            if (find_persons(conn, batch, results) != SQLITE_OK) {
+                return;
+            }
+            for (size_t i = 0; i < results.size(); ++i) {
+                batch_found += results[i].found;
+                in_order = in_order && results[i].person.id_card_number == batch[i];
+            }
+        }
+        double batch_seconds = seconds_since(start);
+
+        printf("%8zu %14.2f %14.2f %10.2f %8s\n", batch_size, loop_seconds * 1e6 / total_ids,
+            batch_seconds * 1e6 / total_ids, loop_seconds / batch_seconds,
+            loop_found == batch_found && in_order ? "yes" : "NO");
+    }
+
+    conn.close();
+    remove_database(filename);
+}
+
+// 保持 outstanding 个请求在途，共发出 total 个请求；make(i) 发出第 i 个请求并返回其 future。
+// 按发出顺序取结果，延迟为发出到取到结果的时间（请求基本按顺序完成，先完成的请求会多算一点等待）
+template <typename T>
+static void run_pipelined(const char* name, size_t total, size_t outstanding, const std::function<std::future<T>(size_t)>& make) {
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    std::deque<std::pair<TimePoint, std::future<T>>> window;
+    std::vector<double> latencies;
+    latencies.reserve(total);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < total || !window.empty();) {
+        if (i < total && window.size() < outstanding) {
+            TimePoint issued = std::chrono::steady_clock::now();
+            window.emplace_back(issued, make(i++));
+            continue;
+        }
+        window.front().second.get();
+        latencies.push_back(seconds_since(window.front().first) * 1e6);
+        window.pop_front();
+    }
+    double seconds = seconds_since(start);
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-26s %10zu %12.0f %10.0f %10.0f %10.0f\n", name, outstanding, total / seconds, latencies[latencies.size() / 2],
+        latencies[latencies.size() * 99 / 100], latencies.back());
+}
+
+// 异步接口在 1000 个请求在途时的吞吐与延迟：查询、插入（组提交与逐条提交）、90% 查询 10% 更新的混合负载
+static void bench_async(size_t count) {
+    const std::string filename = "bench_async.db";
+    std::vector<std::string> ids = generate_ids(count, 1);
+    {
+        Connection conn;
+        if (!open_fresh_database(conn, filename) || insert_person_batch(conn, make_people(ids), 100000) != SQLITE_OK) {
+            return;
+        }
+    }
+    std::vector<Person> new_people = make_people(generate_ids(100000, 2));
+    std::mt19937_64 rng(11);
+    const size_t outstanding = 1000;
+    const size_t readers = 4;
+
+    printf("%-26s %10s %12s %10s %10s %10s\n", "workload", "in flight", "requests/s", "p50 us", "p99 us", "max us");
+    for (size_t group_limit : { (size_t)1000, (size_t)1 }) {
+        AsyncPersonDb db;
+        if (db.open(filename, readers, group_limit) != SQLITE_OK) {
+            return;
+        }
+        if (group_limit > 1) {
+            run_pipelined<PersonLookup>("get", 200000, outstanding, [&](size_t) { return db.get(ids[rng() % ids.size()]); });
+        }
+        size_t offset = group_limit > 1 ? 0 : new_people.size() / 2;  // 两组插入使用不同的身份证号
+        size_t inserts = group_limit > 1 ? new_people.size() / 2 : 5000;  // 逐条提交太慢，只插入 5000 条
+        run_pipelined<int>(group_limit > 1 ? "insert (group commit)" : "insert (commit per write)", inserts, outstanding,
+            [&](size_t i) { return db.insert(new_people[offset + i]); });
+        printf("%-26s average %.1f writes per commit\n", "", (double)db.writes() / db.commits());
+        if (group_limit > 1) {
+            run_pipelined<int>("90% get / 10% update", 200000, outstanding, [&](size_t i) {
+                const std::string& id = ids[rng() % ids.size()];
+                if (i % 10 == 0) {
+                    return db.update(id, "李四", "13900000000");
+                }
+                return std::async(std::launch::deferred, [](std::future<PersonLookup> f) { return f.get().found ? 0 : 1; },
+                    db.get(id));
+            });
+        }
+        db.close();
+    }
+
+    remove_database(filename);
+}
+
+// 输出 EXPLAIN QUERY PLAN 的结果
+static void explain(Connection& conn, const char* sql) {
+    std::string query = std::string("EXPLAIN QUERY PLAN ") + sql;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(conn.handle(), query.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        return;
+    }
+    printf("  %s\n", sql);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        printf("    -> %s\n", reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)));
+    }
+    sqlite3_finalize(stmt);
+}
+
+// 对 queries 中的每个参数调用 query，输出平均与 p99 延迟、平均返回行数
+static void time_queries(const char* name, const std::vector<std::string>& queries,
+    const std::function<size_t(const std::string&)>& query) {
+    std::vector<double> latencies;
+    size_t rows = 0;
+    for (const std::string& q : queries) {
+        auto start = std::chrono::steady_clock::now();
+        rows += query(q);
+        latencies.push_back(seconds_since(start) * 1e6);
+    }
+    double total = 0;
+    for (double l : latencies) {
+        total += l;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-34s %8zu %12.1f %12.1f %12.1f\n", name, queries.size(), total / queries.size(),
+        latencies[latencies.size() * 99 / 100], (double)rows / queries.size());
+}
+
+// 覆盖索引前后按电话、姓名、出生日期范围查询的延迟，以及建索引耗时、文件大小与查询计划
+static void bench_index(size_t count) {
+    const std::string filename = "bench_index.db";
+    if (!populate_sorted(filename, count)) {
+        return;
+    }
+    std::vector<std::string> ids = generate_ids(std::min(count, (size_t)1000000), 1);  // 与 populate_sorted 的前若干行相同
+    std::mt19937_64 rng(13);
+    std::vector<std::string> phones, names, years, decades;
+    for (size_t i = 0; i < 1000; ++i) {
+        Person p = make_person(ids[rng() % ids.size()]);
+        phones.push_back(p.phone);
+        names.push_back(p.name);
+        years.push_back(p.birth_date.substr(0, 4));
+        decades.push_back(p.birth_date.substr(0, 3));
+    }
+
+    Connection conn;
+    conn.open(filename);
+    const char* phone_sql = "SELECT id_card_number, name, gender, birth_date, address, phone FROM person_info WHERE phone = ?;";
+    const char* name_sql = "SELECT id_card_number, name, gender, birth_date, address, phone FROM person_info WHERE name = ?;";
+    const char* birth_sql = "SELECT id_card_number, name, gender, birth_date, address, phone FROM person_info "
+                            "WHERE birth_date BETWEEN ? AND ? ORDER BY birth_date;";
+    auto by_phone = [&](const std::string& phone) {
+        std::vector<Person> people;
+        get_person_by_phone(conn, phone, people);
+        return people.size();
+    };
+    auto by_name = [&](const std::string& name) {
+        std::vector<Person> people;
+        get_persons_by_name(conn, name, people);
+        return people.size();
+    };
+    auto in_year = [&](const std::string& year) {
+        std::vector<Person> people;
+        get_persons_born_between(conn, year + "-01-01", year + "-12-31", people);
+        return people.size();
+    };
+    auto in_decade = [&](const std::string& decade) {
+        std::vector<Person> people;
+        get_persons_born_between(conn, decade + "0-01-01", decade + "9-12-31", people);
+        return people.size();
+    };
+
+    printf("%zu rows, database %.1f MB\n", count, file_size(filename) / 1e6);
+    printf("without indexes:\n");
+    explain(conn, phone_sql);
+    explain(conn, name_sql);
+    explain(conn, birth_sql);
+    printf("%-34s %8s %12s %12s %12s\n", "query", "queries", "avg us", "p99 us", "rows/query");
+    std::vector<std::string> few_phones(phones.begin(), phones.begin() + 3);
+    time_queries("phone (full scan)", few_phones, by_phone);
+
+    auto start = std::chrono::steady_clock::now();
+    if (create_indexes(conn) != SQLITE_OK) {
+        return;
+    }
+    printf("create_indexes: %.1f s, database %.1f MB\n", seconds_since(start), file_size(filename) / 1e6);
+    printf("with covering indexes:\n");
+    explain(conn, phone_sql);
+    explain(conn, name_sql);
+    explain(conn, birth_sql);
+    printf("%-34s %8s %12s %12s %12s\n", "query", "queries", "avg us", "p99 us", "rows/query");
+    time_queries("get_person_by_phone", phones, by_phone);
+    time_queries("get_persons_by_name", std::vector<std::string>(names.begin(), names.begin() + 100), by_name);
+    time_queries("get_persons_born_between (1 year)", years, in_year);
+    time_queries("get_persons_born_between (10 yrs)", std::vector<std::string>(decades.begin(), decades.begin() + 100), in_decade);
+
+    conn.close();
+    remove_database(filename);
+}
+
+// 语句缓存前后的插入与点查吞吐；插入都放在同一个事务里，只比较 SQL 解析与执行的开销
+static void bench_statement_cache(size_t count) {
+    std::vector<std::string> ids = generate_ids(count, 1);
+    std::vector<Person> people = make_people(ids);
+    std::vector<std::string> queries = ids;
+    std::shuffle(queries.begin(), queries.end(), std::mt19937_64(3));
+
+    for (bool cached : { false, true }) {
+        const std::string filename = cached ? "bench_cached.db" : "bench_uncached.db";
+        Connection conn;
+        if (!open_fresh_database(conn, filename)) {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        conn.exec("BEGIN;");
+        for (const Person& p : people) {
+            int rc = cached
+                ? insert_person_info(conn, p.id_card_number, p.name, p.gender, p.birth_date, p.address, p.phone)
+                : insert_uncached(conn.handle(), p);
+            if (rc != SQLITE_OK) {
+                std::cerr << "Insert failed: " << p.id_card_number << std::endl;
+                return;
+            }
+        }
+        conn.exec("COMMIT;");
+        double insert_seconds = seconds_since(start);
+
+        size_t found = 0;
+        Person person;
+        start = std::chrono::steady_clock::now();
+        for (const std::string& id : queries) {
+            int rc = cached ? find_person(conn, id, person) : find_uncached(conn.handle(), id, person);
+            found += rc == SQLITE_ROW;
+        }
+        double lookup_seconds = seconds_since(start);
+
+        printf("[%s] insert %zu rows: %.2f s (%.0f rows/s), lookup %zu: %.2f s (%.1f us/lookup, found %zu)\n",
+            cached ? "cached" : "prepare-per-call", people.size(), insert_seconds, people.size() / insert_seconds,
+            queries.size(), lookup_seconds, lookup_seconds * 1e6 / queries.size(), found);
+
+        conn.close();
+        std::remove(filename.c_str());
+    }
+}
+
+// 不同事务大小与日志模式下的批量导入速度（synchronous 保持默认的 FULL）。
+// 每个事务提交都要落盘，batch_size 很小时逐条提交太慢，只导入前 small_batch_rows 行来估算速度
+static void bench_batch_insert(size_t count) {
+    const size_t small_batch_rows = 20000;
+    std::vector<Person> people = make_people(generate_ids(count, 1));
+    std::vector<Person> head(people.begin(), people.begin() + std::min(people.size(), small_batch_rows));
+    const std::string filename = "bench_batch.db";
+
+    printf("%-10s %10s %10s %10s %14s\n", "journal", "batch", "rows", "seconds", "rows/s");
+    for (const char* journal : { "DELETE", "TRUNCATE", "WAL", "MEMORY" }) {
+        for (size_t batch_size : { (size_t)1, (size_t)100, (size_t)1000, (size_t)10000, (size_t)100000 }) {
+            Connection conn;
+            if (!open_fresh_database(conn, filename)) {
+                return;
+            }
+            std::string pragma = std::string("PRAGMA journal_mode = ") + journal + ";";
+            conn.exec(pragma.c_str());
+
+            const std::vector<Person>& rows = batch_size < 1000 ? head : people;
+            double rows_per_second = 0;
+            auto start = std::chrono::steady_clock::now();
+            if (insert_person_batch(conn, rows, batch_size, &rows_per_second) != SQLITE_OK) {
+                std::cerr << "Batch insert failed" << std::endl;
+                return;
+            }
+            printf("%-10s %10zu %10zu %10.2f %14.0f\n", journal, batch_size, rows.size(), seconds_since(start),
+                rows_per_second);
+        }
+    }
+    remove_database(filename);
+}
+
+// 连接池的并行点查 QPS：threads 个读线程分块执行 queries 次查找，可同时让写线程以 1000 行一个事务持续导入新数据。
+// 最后完成的读任务记录结束时间并通知写线程停止
+static void bench_pool_lookup(ConnectionPool& pool, const std::vector<std::string>& queries,
+    const std::vector<Person>& new_people, bool with_writer) {
+    const size_t chunk = 1000;
+    const size_t chunks = (queries.size() + chunk - 1) / chunk;
+    std::atomic<size_t> remaining(chunks);
+    std::atomic<size_t> found(0);
+    std::atomic<bool> stop(false);
+    std::chrono::steady_clock::time_point read_end;
+    size_t written = 0;
+    double write_seconds = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    if (with_writer) {
+        pool.submitWrite([&](Connection& conn) {
+            auto write_start = std::chrono::steady_clock::now();
+            while (!stop.load() && written < new_people.size()) {
+                size_t end = std::min(new_people.size(), written + chunk);
+                std::vector<Person> batch(new_people.begin() + written, new_people.begin() + end);
+                if (insert_person_batch(conn, batch, batch.size()) != SQLITE_OK) {
+                    break;
+                }
+                written = end;
+            }
+            write_seconds = seconds_since(write_start);
+        });
+    }
+    for (size_t c = 0; c < chunks; ++c) {
+        pool.submitRead([&, c](Connection& conn) {
+            Person person;
+            size_t hits = 0;
+            size_t end = std::min(queries.size(), (c + 1) * chunk);
+            for (size_t i = c * chunk; i < end; ++i) {
+                hits += find_person(conn, queries[i], person) == SQLITE_ROW;
+            }
+            found += hits;
+            if (--remaining == 0) {
+                read_end = std::chrono::steady_clock::now();
+                stop = true;
+            }
+        });
+    }
+    pool.wait();
+
+    double read_seconds = std::chrono::duration<double>(read_end - start).count();
+    printf("%8zu %8s %12.0f %10zu %14.0f\n", pool.readerCount(), with_writer ? "yes" : "no",
+        queries.size() / read_seconds, found.load(), with_writer && write_seconds > 0 ? written / write_seconds : 0.0);
+}
+
+// WAL 连接池在不同读线程数下的点查 QPS，以及同时导入时的 QPS 与导入速度
+static void bench_pool(size_t count) {
+    const std::string filename = "bench_pool.db";
+    std::vector<std::string> ids = generate_ids(count, 1);
+    {
+        Connection conn;
+        if (!open_fresh_database(conn, filename) || insert_person_batch(conn, make_people(ids), 100000) != SQLITE_OK) {
+            return;
+        }
+    }
+
+    std::vector<std::string> queries = ids;
+    std::shuffle(queries.begin(), queries.end(), std::mt19937_64(3));
+    queries.resize(std::min(queries.size(), (size_t)200000));
+    std::vector<Person> new_people = make_people(generate_ids(count, 2));
+
+    printf("%8s %8s %12s %10s %14s\n", "readers", "writer", "lookups/s", "found", "written rows/s");
+    for (size_t threads : { (size_t)1, (size_t)2, (size_t)4, (size_t)8 }) {
+        for (bool with_writer : { false, true }) {
+            ConnectionPool pool;
+            if (pool.open(filename, threads) != SQLITE_OK) {
+                return;
+            }
+            bench_pool_lookup(pool, queries, new_people, with_writer);
+            pool.close();
+
+            // 撤销写线程导入的数据，各组测试使用同一份数据
+            if (with_writer) {
+                Connection conn;
+                conn.open(filename);
+                conn.exec(("DELETE FROM person_info WHERE rowid > " + std::to_string(count) + ";").c_str());
+            }
+        }
+    }
+    remove_database(filename);
+}
+
+int run_benchmark(int argc, char* argv[]) {
+    std::string mode = argc > 0 ? argv[0] : "stmtcache";
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+
+    if (mode == "stmtcache") {
+        bench_statement_cache(count);
+    }
+    else if (mode == "batch") {
+        bench_batch_insert(count);
+    }
+    else if (mode == "pool") {
+        bench_pool(count);
+    }
+    else if (mode == "export") {
+        bench_export(count);
+    }
+    else if (mode == "parallel") {
+        bench_parallel_export(count);
+    }
+    else if (mode == "import") {
+        bench_import(count);
+    }
+    else if (mode == "schema") {
+        bench_schema(count);
+    }
+    else if (mode == "cache") {
+        bench_cache(count);
+    }
+    else if (mode == "multiget") {
+        bench_multi_get(count);
+    }
+    else if (mode == "async") {
+        bench_async(count);
+    }
+    else if (mode == "index") {
+        bench_index(count);
+    }
+    else {
+        std::cerr << "Unknown benchmark: " << mode << std::endl;
+        return 1;
+    }
+    return 0;
+}
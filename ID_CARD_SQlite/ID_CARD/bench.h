@@ -0,0 +1,4 @@
+#pragma once
+
+// 性能测试入口：ID_CARD bench <测试名> [参数...]，argv[0] 为测试名
+int run_benchmark(int argc, char* argv[]);
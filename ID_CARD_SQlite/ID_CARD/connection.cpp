@@ -0,0 +1,61 @@
+#include "connection.h"
+#include <iostream>
+
+Connection::Connection() : db(nullptr) {}
+
+Connection::~Connection() {
+    close();
+}
+
+int Connection::open(const std::string& filename, int flags) {
+    close();
+    int rc = sqlite3_open_v2(filename.c_str(), &db, flags, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "Can't open database: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_close(db);  // 打开失败时 db 也可能已分配，需要关闭
+        db = nullptr;
+    }
+    return rc;
+}
+
+void Connection::close() {
+    for (auto& entry : statements) {
+        sqlite3_finalize(entry.second);  // 释放 SQL 语句资源
+    }
+    statements.clear();
+    by_address.clear();
+    if (db) {
+        sqlite3_close(db);
+        db = nullptr;
+    }
+}
+
+sqlite3_stmt* Connection::statement(const char* sql) {
+    auto hit = by_address.find(sql);
+    if (hit != by_address.end() && *hit->second.sql == sql) {
+        return hit->second.stmt;
+    }
+
+    auto it = statements.find(sql);
+    if (it == statements.end()) {
+        sqlite3_stmt* stmt = nullptr;
+        int rc = sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);  // 语句会长期复用
+        if (rc != SQLITE_OK) {
+            std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db) << std::endl;
+            return nullptr;
+        }
+        it = statements.emplace(sql, stmt).first;
+    }
+    by_address[sql] = CachedStatement{ &it->first, it->second };  // unordered_map 的键地址在重新散列后不变
+    return it->second;
+}
+
+int Connection::exec(const char* sql) {
+    char* err_msg = nullptr;  // 错误消息
+    int rc = sqlite3_exec(db, sql, nullptr, nullptr, &err_msg);
+    if (rc != SQLITE_OK) {
+        std::cerr << "SQL error: " << (err_msg ? err_msg : sqlite3_errmsg(db)) << std::endl;
+        sqlite3_free(err_msg);  // 释放错误消息
+    }
+    return rc;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <sqlite3.h>  // SQLite3 库
+#include <string>
+#include <unordered_map>
+
+// 数据库连接：封装 sqlite3*，并缓存预编译语句。
+// 每条 SQL 只在第一次使用时调用 sqlite3_prepare_v2，之后直接复用，避免每次调用都重新解析 SQL
+class Connection {
+public:
+    Connection();
+    ~Connection();
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    // 打开数据库，返回 SQLite 结果码
+    int open(const std::string& filename, int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+    // 释放所有缓存的语句并关闭数据库
+    void close();
+
+    // 返回 sql 对应的预编译语句，第一次调用时 prepare 并缓存；失败时输出错误并返回 nullptr。
+    // 返回的语句已处于可重新执行的状态，用完后应由 StatementScope 负责 reset
+    sqlite3_stmt* statement(const char* sql);
+
+    // 执行不需要返回结果的 SQL（建表、事务控制、PRAGMA 等），失败时输出错误
+    int exec(const char* sql);
+
+    sqlite3* handle() const { return db; }
+    size_t cachedStatements() const { return statements.size(); }
+
+private:
+    struct CachedStatement {
+        const std::string* sql;  // 指向 statements 中的键，用于核对文本
+        sqlite3_stmt* stmt;
+    };
+
+    sqlite3* db;  // SQLite3 数据库对象
+    std::unordered_map<std::string, sqlite3_stmt*> statements;  // SQL 文本 -> 预编译语句
+    // SQL 字符串地址 -> 语句。调用方通常传字符串字面量，地址不变，按地址查找不必构造 std::string 和哈希整段文本；
+    // 命中后仍核对文本，地址被其他 SQL 复用时回退到按文本查找
+    std::unordered_map<const char*, CachedStatement> by_address;
+};
+
+// 在作用域结束时对缓存的语句调用 sqlite3_reset 与 sqlite3_clear_bindings，
+// 保证无论从哪个分支返回，语句都能被下一次调用复用
+class StatementScope {
+public:
+    explicit StatementScope(sqlite3_stmt* stmt) : stmt(stmt) {}
+
+    ~StatementScope() {
+        if (stmt) {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+    }
+
+    StatementScope(const StatementScope&) = delete;
+    StatementScope& operator=(const StatementScope&) = delete;
+
+    sqlite3_stmt* get() const { return stmt; }
+
+private:
+    sqlite3_stmt* stmt;
+};
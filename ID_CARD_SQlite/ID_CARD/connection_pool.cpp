@@ -0,0 +1,140 @@
+#include "connection_pool.h"
+#include <cstring>
+#include <iostream>
+
+ConnectionPool::ConnectionPool() : pending(0), stopping(false) {}
+
+ConnectionPool::~ConnectionPool() {
+    close();
+}
+
+// 切换到 WAL 模式并确认已生效：PRAGMA 返回实际使用的模式，:memory: 数据库为 memory，
+// 其他连接以回滚日志模式打开着文件时仍为原模式。未切换成功时返回错误码
+static int enable_wal(Connection& conn) {
+    StatementScope scope(conn.statement("PRAGMA journal_mode = WAL;"));
+    if (!scope.get()) {
+        return SQLITE_ERROR;
+    }
+    int rc = sqlite3_step(scope.get());
+    if (rc != SQLITE_ROW) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+        return rc;
+    }
+    const char* mode = reinterpret_cast<const char*>(sqlite3_column_text(scope.get(), 0));
+    if (!mode || std::strcmp(mode, "wal") != 0) {
+        std::cerr << "无法切换到 WAL 模式，当前日志模式为 " << (mode ? mode : "") << std::endl;
+        return SQLITE_ERROR;
+    }
+    return SQLITE_OK;
+}
+
+int ConnectionPool::open(const std::string& filename, size_t reader_count) {
+    close();
+    if (reader_count == 0) {
+        return SQLITE_MISUSE;  // 没有读线程时读任务永远不会执行，wait() 会一直阻塞
+    }
+    stopping = false;
+
+    // 每个连接只在一个线程上使用，不需要 SQLite 的连接级互斥锁
+    std::unique_ptr<Worker> w(new Worker());
+    int rc = w->conn.open(filename, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+    if (rc != SQLITE_OK) {
+        return rc;
+    }
+    // 读连接做检查点或恢复 WAL 索引时可能短暂持有锁，写连接同样需要等待而不是立即返回 SQLITE_BUSY
+    sqlite3_busy_timeout(w->conn.handle(), 5000);
+    // WAL 模式记录在数据库文件中，之后打开的只读连接也使用 WAL；WAL 下 synchronous = NORMAL 仍能保证数据库不损坏。
+    // 不是 WAL 时读会阻塞写，连接池失去意义，直接失败
+    if ((rc = enable_wal(w->conn)) != SQLITE_OK ||
+        (rc = w->conn.exec("PRAGMA synchronous = NORMAL;")) != SQLITE_OK) {
+        return rc;
+    }
+
+    std::vector<std::unique_ptr<Worker>> opened;
+    for (size_t i = 0; i < reader_count; ++i) {
+        std::unique_ptr<Worker> r(new Worker());
+        rc = r->conn.open(filename, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+        if (rc != SQLITE_OK) {
+            return rc;
+        }
+        sqlite3_busy_timeout(r->conn.handle(), 5000);  // 写连接做检查点时可能短暂持有锁
+        opened.push_back(std::move(r));
+    }
+
+    writer = std::move(w);
+    readers = std::move(opened);
+    writer->thread = std::thread(&ConnectionPool::run, this, writer.get(), &write_queue);
+    for (auto& r : readers) {
+        r->thread = std::thread(&ConnectionPool::run, this, r.get(), &read_queue);
+    }
+    return SQLITE_OK;
+}
+
+void ConnectionPool::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_ready.notify_all();
+
+    // 先停读线程并关闭只读连接，最后关闭写连接，由它完成 WAL 检查点
+    for (auto& r : readers) {
+        if (r->thread.joinable()) {
+            r->thread.join();
+        }
+        r->conn.close();
+    }
+    readers.clear();
+    if (writer) {
+        if (writer->thread.joinable()) {
+            writer->thread.join();
+        }
+        writer->conn.close();
+        writer.reset();
+    }
+}
+
+void ConnectionPool::submitRead(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        read_queue.push_back(std::move(task));
+        ++pending;
+    }
+    work_ready.notify_all();
+}
+
+void ConnectionPool::submitWrite(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        write_queue.push_back(std::move(task));
+        ++pending;
+    }
+    work_ready.notify_all();
+}
+
+void ConnectionPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pending == 0; });
+}
+
+void ConnectionPool::run(Worker* worker, std::deque<Task>* queue) {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_ready.wait(lock, [&]() { return stopping || !queue->empty(); });
+            if (queue->empty()) {
+                return;  // 停止前先把队列中的任务执行完
+            }
+            task = std::move(queue->front());
+            queue->pop_front();
+        }
+
+        task(worker->conn);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) {
+            idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "connection.h"
+
+// WAL 模式连接池：一个写连接和 N 个只读连接，每个连接固定属于一个工作线程，只在该线程上使用。
+// WAL 模式下读不阻塞写、写也不阻塞读，点查可以在导入进行的同时并行执行。
+// 读任务放进共享队列，由任意一个空闲的读线程取走；写任务由唯一的写线程按提交顺序执行
+class ConnectionPool {
+public:
+    typedef std::function<void(Connection&)> Task;
+
+    ConnectionPool();
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // 打开数据库并切换到 WAL 模式，启动 1 个写线程和 reader_count 个读线程；返回 SQLite 结果码。
+    // reader_count 至少为 1，为 0 时返回 SQLITE_MISUSE
+    int open(const std::string& filename, size_t reader_count);
+
+    // 执行完已提交的任务后停止所有线程并关闭连接
+    void close();
+
+    // 提交读任务，任务在某个读线程上以该线程的只读连接执行
+    void submitRead(Task task);
+
+    // 提交写任务，任务在写线程上以写连接执行
+    void submitWrite(Task task);
+
+    // 阻塞直到已提交的读写任务全部执行完
+    void wait();
+
+    size_t readerCount() const { return readers.size(); }
+
+private:
+    struct Worker {
+        Connection conn;
+        std::thread thread;
+    };
+
+    void run(Worker* worker, std::deque<Task>* queue);
+
+    std::unique_ptr<Worker> writer;
+    std::vector<std::unique_ptr<Worker>> readers;
+    std::deque<Task> read_queue;
+    std::deque<Task> write_queue;
+    std::mutex mutex;
+    std::condition_variable work_ready;  // 有新任务或需要停止
+    std::condition_variable idle;        // pending 降为 0
+    size_t pending;                      // 已提交但尚未执行完的任务数
+    bool stopping;
+};
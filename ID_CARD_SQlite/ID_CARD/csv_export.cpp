@@ -0,0 +1,296 @@
+#include "csv_export.h"
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+CsvWriter::CsvWriter(size_t buffer_size)
+    : file(nullptr), buffer(buffer_size), used(0), flushed(0), row_started(false), failed(false) {}
+
+CsvWriter::~CsvWriter() {
+    close();
+}
+
+bool CsvWriter::open(const std::string& filename) {
+    close();
+    file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        std::cerr << "无法创建 CSV 文件: " << filename << std::endl;
+        return false;
+    }
+    std::setvbuf(file, nullptr, _IONBF, 0);  // 已自行缓冲，不需要 stdio 再复制一次
+    used = 0;
+    flushed = 0;
+    row_started = false;
+    failed = false;
+    return true;
+}
+
+bool CsvWriter::close() {
+    if (!file) {
+        return !failed;
+    }
+    flush();
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+void CsvWriter::flush() {
+    if (used > 0 && file) {
+        if (std::fwrite(buffer.data(), 1, used, file) != used) {
+            failed = true;
+        }
+        flushed += used;
+    }
+    used = 0;
+}
+
+void CsvWriter::write(const char* data, size_t size) {
+    reserve(size);
+    std::memcpy(buffer.data() + used, data, size);
+    used += size;
+}
+
+// 需要加引号的字符：逗号、双引号、换行
+static bool needs_quote(unsigned char c) {
+    return c == ',' || c == '"' || c == '\n' || c == '\r';
+}
+
+void CsvWriter::field(const char* data, size_t size) {
+    // 先用无分支的按位或判断整个字段是否含特殊字符，绝大多数字段不含，直接整段复制
+    static const struct QuoteTable {
+        unsigned char special[256];
+        QuoteTable() {
+            for (int c = 0; c < 256; ++c) {
+                special[c] = needs_quote((unsigned char)c);
+            }
+        }
+    } table;
+    unsigned char special = 0;
+    for (size_t i = 0; i < size; ++i) {
+        special |= table.special[(unsigned char)data[i]];
+    }
+    bool quote = special != 0;
+    size_t quotes = 0;
+    if (quote) {
+        for (size_t i = 0; i < size; ++i) {
+            quotes += data[i] == '"';
+        }
+    }
+
+    reserve(size + quotes + 3);  // 分隔逗号与两侧引号
+    char* out = buffer.data() + used;
+    if (row_started) {
+        *out++ = ',';
+    }
+    row_started = true;
+
+    if (!quote) {
+        std::memcpy(out, data, size);
+        out += size;
+    }
+    else {
+        *out++ = '"';
+        for (size_t i = 0; i < size; ++i) {
+            if (data[i] == '"') {
+                *out++ = '"';
+            }
+            *out++ = data[i];
+        }
+        *out++ = '"';
+    }
+    used = out - buffer.data();
+}
+
+void CsvWriter::endRow() {
+    reserve(1);
+    buffer[used++] = '\n';
+    row_started = false;
+}
+
+int write_csv_rows(Connection& conn, sqlite3_stmt* stmt, CsvWriter& writer, size_t* rows) {
+    size_t count = 0;
+    int columns = sqlite3_column_count(stmt);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        for (int i = 0; i < columns; ++i) {
+            const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+            if (text) {
+                writer.field(text, sqlite3_column_bytes(stmt, i));  // 先取文本再取长度，长度对应 UTF-8 文本
+            }
+            else {
+                writer.field("NULL", 4);
+            }
+        }
+        writer.endRow();
+        ++count;
+    }
+
+    if (rows) {
+        *rows = count;
+    }
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+        return rc;
+    }
+    return SQLITE_OK;
+}
+
+int export_csv(Connection& conn, const std::string& filename, size_t* bytes) {
+    CsvWriter writer;
+    if (!writer.open(filename)) {
+        return SQLITE_CANTOPEN;
+    }
+
+    // 向 CSV 文件写入 UTF-8 BOM（字节顺序标记）
+    const unsigned char utf8_bom[3] = { 0xEF, 0xBB, 0xBF };
+    writer.write(reinterpret_cast<const char*>(utf8_bom), 3);
+
+    StatementScope scope(conn.statement("SELECT * FROM person_info;"));
+    if (!scope.get()) {
+        return SQLITE_ERROR;
+    }
+    int rc = write_csv_rows(conn, scope.get(), writer);
+    if (bytes) {
+        *bytes = writer.bytesWritten();
+    }
+    if (!writer.close()) {
+        std::cerr << "写入 CSV 文件失败: " << filename << std::endl;
+        return rc == SQLITE_OK ? SQLITE_IOERR : rc;
+    }
+    return rc;
+}
+
+// 第 index 个分段文件名
+static std::string part_filename(const std::string& csv_filename, size_t index) {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), ".part%03zu", index);
+    return csv_filename + suffix;
+}
+
+// 导出 rowid 在 [first, last] 内的行；每个线程使用自己的只读连接
+static int export_rowid_range(const std::string& db_filename, const std::string& filename,
+    sqlite3_int64 first, sqlite3_int64 last, bool with_bom, size_t* bytes) {
+    Connection conn;
+    int rc = conn.open(db_filename, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+    if (rc != SQLITE_OK) {
+        return rc;
+    }
+    CsvWriter writer;
+    if (!writer.open(filename)) {
+        return SQLITE_CANTOPEN;
+    }
+    if (with_bom) {
+        const unsigned char utf8_bom[3] = { 0xEF, 0xBB, 0xBF };
+        writer.write(reinterpret_cast<const char*>(utf8_bom), 3);
+    }
+
+    StatementScope scope(conn.statement("SELECT * FROM person_info WHERE rowid BETWEEN ? AND ?;"));
+    if (!scope.get()) {
+        return SQLITE_ERROR;
+    }
+    sqlite3_bind_int64(scope.get(), 1, first);
+    sqlite3_bind_int64(scope.get(), 2, last);
+    rc = write_csv_rows(conn, scope.get(), writer);
+    *bytes = writer.bytesWritten();
+    if (!writer.close() && rc == SQLITE_OK) {
+        std::cerr << "写入 CSV 文件失败: " << filename << std::endl;
+        rc = SQLITE_IOERR;
+    }
+    return rc;
+}
+
+// 把分段文件追加到 out
+static bool append_part(std::FILE* out, const std::string& filename, std::vector<char>& buffer) {
+    std::FILE* in = std::fopen(filename.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+    bool ok = true;
+    size_t n;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), in)) > 0) {
+        if (std::fwrite(buffer.data(), 1, n, out) != n) {
+            ok = false;
+            break;
+        }
+    }
+    std::fclose(in);
+    return ok;
+}
+
+int export_csv_parallel(const std::string& db_filename, const std::string& csv_filename, size_t parts,
+    bool keep_parts, size_t* bytes) {
+    if (parts == 0) {
+        parts = 1;
+    }
+
+    // 取 rowid 范围，按 rowid 等分；rowid 基本连续时各段行数接近
+    sqlite3_int64 min_rowid = 0, max_rowid = -1;
+    {
+        Connection conn;
+        int rc = conn.open(db_filename, SQLITE_OPEN_READONLY);
+        if (rc != SQLITE_OK) {
+            return rc;
+        }
+        StatementScope scope(conn.statement("SELECT min(rowid), max(rowid) FROM person_info;"));
+        if (!scope.get()) {
+            return SQLITE_ERROR;
+        }
+        if (sqlite3_step(scope.get()) == SQLITE_ROW && sqlite3_column_type(scope.get(), 0) != SQLITE_NULL) {
+            min_rowid = sqlite3_column_int64(scope.get(), 0);
+            max_rowid = sqlite3_column_int64(scope.get(), 1);
+        }
+    }
+    sqlite3_uint64 span = max_rowid >= min_rowid ? (sqlite3_uint64)(max_rowid - min_rowid) + 1 : 0;
+    sqlite3_uint64 step = span / parts + (span % parts != 0);
+
+    std::vector<int> results(parts, SQLITE_OK);
+    std::vector<size_t> part_bytes(parts, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < parts; ++i) {
+        sqlite3_int64 first = min_rowid + (sqlite3_int64)(step * i);
+        sqlite3_int64 last = i + 1 == parts ? max_rowid : first + (sqlite3_int64)step - 1;
+        threads.emplace_back([&, i, first, last]() {
+            results[i] = export_rowid_range(db_filename, part_filename(csv_filename, i), first, last, i == 0,
+                &part_bytes[i]);
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    size_t total = 0;
+    int rc = SQLITE_OK;
+    for (size_t i = 0; i < parts; ++i) {
+        total += part_bytes[i];
+        if (rc == SQLITE_OK) {
+            rc = results[i];
+        }
+    }
+    if (bytes) {
+        *bytes = total;
+    }
+
+    if (!keep_parts) {
+        std::FILE* out = rc == SQLITE_OK ? std::fopen(csv_filename.c_str(), "wb") : nullptr;
+        if (rc == SQLITE_OK && !out) {
+            std::cerr << "无法创建 CSV 文件: " << csv_filename << std::endl;
+            rc = SQLITE_CANTOPEN;
+        }
+        std::vector<char> buffer(1 << 20);
+        for (size_t i = 0; i < parts; ++i) {
+            std::string part = part_filename(csv_filename, i);
+            if (out && !append_part(out, part, buffer)) {
+                std::cerr << "拼接 CSV 文件失败: " << part << std::endl;
+                rc = SQLITE_IOERR;
+            }
+            std::remove(part.c_str());
+        }
+        if (out && std::fclose(out) != 0 && rc == SQLITE_OK) {
+            rc = SQLITE_IOERR;
+        }
+    }
+    return rc;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "connection.h"
+
+// 带大缓冲区的 CSV 写入器：字段先拼进内存缓冲区，缓冲区满时一次 fwrite 写出，
+// 避免逐字段经过 ofstream 的格式化与虚函数调用
+class CsvWriter {
+public:
+    explicit CsvWriter(size_t buffer_size = 1 << 20);
+    ~CsvWriter();
+
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    // 创建（覆盖）文件，失败时输出错误并返回 false
+    bool open(const std::string& filename);
+
+    // 写出缓冲区剩余内容并关闭文件；写入失败时返回 false
+    bool close();
+
+    // 原样写入字节（BOM 等）
+    void write(const char* data, size_t size);
+
+    // 写入一个字段：含逗号、双引号或换行时用双引号包围，内部的双引号写成两个；非首字段前自动加逗号
+    void field(const char* data, size_t size);
+
+    // 结束当前行
+    void endRow();
+
+    // 已写入（含缓冲区中未写出）的字节数
+    size_t bytesWritten() const { return flushed + used; }
+
+private:
+    void flush();
+
+    // 保证缓冲区至少还有 size 字节空间
+    void reserve(size_t size) {
+        if (used + size > buffer.size()) {
+            flush();
+            if (size > buffer.size()) {
+                buffer.resize(size);
+            }
+        }
+    }
+
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;         // 缓冲区中已使用的字节数
+    size_t flushed;      // 已写到文件的字节数
+    bool row_started;    // 当前行是否已有字段
+    bool failed;         // fwrite 是否出错
+};
+
+// 逐行执行预编译的查询，用 sqlite3_column_text/sqlite3_column_bytes 直接取字段写入 CSV；NULL 写为 NULL（与旧的导出结果一致）。
+// 返回 SQLite 结果码，rows 非空时写入导出的行数
+int write_csv_rows(Connection& conn, sqlite3_stmt* stmt, CsvWriter& writer, size_t* rows = nullptr);
+
+// 将 person_info 整表导出为带 UTF-8 BOM 的 CSV 文件；返回 SQLite 结果码，bytes 非空时写入文件大小
+int export_csv(Connection& conn, const std::string& filename, size_t* bytes = nullptr);
+
+// 按 rowid 范围把 person_info 分成 parts 段并行导出：每段在自己的线程上打开一个只读连接，写入 csv_filename.partNNN。
+// keep_parts 为 true 时保留分段文件（只有第 0 段带 BOM，按序拼接即为完整 CSV）；否则按顺序拼接到 csv_filename 后删除分段文件。
+// 各段分别在自己的读事务中执行，导出期间有写入时各段看到的可能不是同一个快照。
+// 返回 SQLite 结果码，bytes 非空时写入导出的总字节数
+int export_csv_parallel(const std::string& db_filename, const std::string& csv_filename, size_t parts,
+    bool keep_parts = false, size_t* bytes = nullptr);
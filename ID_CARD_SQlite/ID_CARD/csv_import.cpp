@@ -0,0 +1,346 @@
+#include "csv_import.h"
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <utility>
+
+static const int kColumns = 6;
+
+bool valid_id_card_number(const char* id, size_t size) {
+    static const int weight[17] = { 7, 9, 10, 5, 8, 4, 2, 1, 6, 3, 7, 9, 10, 5, 8, 4, 2 };
+    static const char check_code_map[] = "10X98765432";
+    if (size != 18) {
+        return false;
+    }
+    int total = 0;
+    for (int i = 0; i < 17; ++i) {
+        if (id[i] < '0' || id[i] > '9') {
+            return false;
+        }
+        total += (id[i] - '0') * weight[i];
+    }
+    return id[17] == check_code_map[total % 11];
+}
+
+// CSV 中的一个字段，指向读缓冲区内的字节
+struct CsvField {
+    const char* data;
+    size_t size;
+    bool quoted;
+};
+
+// 分块读入的 CSV 解析器：一次读入 4 MiB，记录跨块时把剩余部分移到缓冲区开头再继续读
+class CsvReader {
+public:
+    CsvReader() : file(nullptr), buffer(4 << 20), pos(0), end(0), eof(false) {}
+    ~CsvReader() {
+        if (file) {
+            std::fclose(file);
+        }
+    }
+
+    bool open(const std::string& filename) {
+        file = std::fopen(filename.c_str(), "rb");
+        if (!file) {
+            return false;
+        }
+        fill();
+        if (end - pos >= 3 && std::memcmp(buffer.data() + pos, "\xEF\xBB\xBF", 3) == 0) {
+            pos += 3;  // 跳过 UTF-8 BOM
+        }
+        return true;
+    }
+
+    // 读出下一条记录的字段（最多 max_fields 个，多余的只计数）；没有更多记录时返回 -1，否则返回字段数
+    int next(CsvField* fields, int max_fields) {
+        for (;;) {
+            if (pos == end && eof) {
+                return -1;
+            }
+            size_t record_end = 0;
+            size_t next_pos = 0;
+            if (findRecord(record_end, next_pos)) {
+                int count = split(pos, record_end, fields, max_fields);
+                pos = next_pos;
+                return count;
+            }
+            fill();
+        }
+    }
+
+private:
+    // 在 [pos, end) 中找到当前记录的结尾（不在引号内的换行）；数据不够且未到文件尾时返回 false
+    bool findRecord(size_t& record_end, size_t& next_pos) {
+        char* data = buffer.data();
+        char* newline = static_cast<char*>(std::memchr(data + pos, '\n', end - pos));
+        size_t limit = newline ? newline - data : end;
+        // 大多数记录不含引号，换行即为记录结尾
+        if (!std::memchr(data + pos, '"', limit - pos)) {
+            if (!newline && !eof) {
+                return false;
+            }
+            record_end = limit;
+            next_pos = newline ? limit + 1 : limit;
+            return true;
+        }
+
+        bool in_quotes = false;
+        for (size_t i = pos; i < end; ++i) {
+            if (data[i] == '"') {
+                in_quotes = !in_quotes;  // 转义的 "" 会切换两次
+            }
+            else if (data[i] == '\n' && !in_quotes) {
+                record_end = i;
+                next_pos = i + 1;
+                return true;
+            }
+        }
+        if (!eof) {
+            return false;
+        }
+        record_end = end;
+        next_pos = end;
+        return true;
+    }
+
+    // 把 [begin, finish) 拆成字段；带引号的字段原地去掉引号与转义
+    int split(size_t begin, size_t finish, CsvField* fields, int max_fields) {
+        char* data = buffer.data();
+        if (finish > begin && data[finish - 1] == '\r') {
+            --finish;  // CRLF 换行
+        }
+        int count = 0;
+        size_t i = begin;
+        for (;;) {
+            CsvField field = { data + i, 0, false };
+            if (i < finish && data[i] == '"') {
+                field.quoted = true;
+                char* out = data + i;
+                field.data = out;
+                ++i;
+                while (i < finish) {
+                    if (data[i] == '"') {
+                        if (i + 1 < finish && data[i + 1] == '"') {
+                            *out++ = '"';
+                            i += 2;
+                            continue;
+                        }
+                        ++i;
+                        break;
+                    }
+                    *out++ = data[i++];
+                }
+                field.size = out - field.data;
+                while (i < finish && data[i] != ',') {
+                    ++i;  // 闭合引号后到逗号之间的多余字符忽略
+                }
+            }
+            else {
+                const char* comma = static_cast<const char*>(std::memchr(data + i, ',', finish - i));
+                size_t stop = comma ? comma - data : finish;
+                field.size = stop - i;
+                i = stop;
+            }
+
+            if (count < max_fields) {
+                fields[count] = field;
+            }
+            ++count;
+            if (i >= finish) {
+                return count;
+            }
+            ++i;  // 跳过逗号
+        }
+    }
+
+    // 把未解析的部分移到缓冲区开头并继续读文件；缓冲区放不下一条记录时扩大一倍
+    void fill() {
+        if (eof) {
+            return;
+        }
+        if (pos > 0) {
+            std::memmove(buffer.data(), buffer.data() + pos, end - pos);
+            end -= pos;
+            pos = 0;
+        }
+        if (end == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        size_t n = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+        end += n;
+        if (n == 0) {
+            eof = true;
+        }
+    }
+
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t pos;   // 下一条记录的起点
+    size_t end;   // 缓冲区中有效数据的结尾
+    bool eof;
+};
+
+// 执行单值 PRAGMA 并返回结果（读取当前值，或设置后实际生效的值）；失败时输出错误并返回空字符串
+static std::string pragma_value(Connection& conn, const char* sql) {
+    std::string value;
+    StatementScope scope(conn.statement(sql));
+    if (!scope.get()) {
+        return value;
+    }
+    int step = sqlite3_step(scope.get());
+    if (step == SQLITE_ROW) {
+        const char* text = reinterpret_cast<const char*>(sqlite3_column_text(scope.get(), 0));
+        value = text ? text : "";
+    }
+    else {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+    }
+    return value;
+}
+
+// 删除 person_info 上的二级索引，把已删除的 (索引名, 建索引语句) 放进 dropped 以便导入后重建；
+// 某个索引删除失败时停止并返回错误码，dropped 中只有已删除的索引
+static int drop_indexes(Connection& conn, std::vector<std::pair<std::string, std::string>>& dropped) {
+    std::vector<std::pair<std::string, std::string>> indexes;
+    {
+        StatementScope scope(conn.statement(
+            "SELECT name, sql FROM sqlite_master WHERE type = 'index' AND tbl_name = 'person_info' AND sql IS NOT NULL;"));
+        if (!scope.get()) {
+            return SQLITE_ERROR;
+        }
+        int step;
+        while ((step = sqlite3_step(scope.get())) == SQLITE_ROW) {
+            indexes.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(scope.get(), 0)),
+                reinterpret_cast<const char*>(sqlite3_column_text(scope.get(), 1)));
+        }
+        if (step != SQLITE_DONE) {
+            std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+            return step;
+        }
+    }
+    for (const auto& index : indexes) {
+        int rc = conn.exec(("DROP INDEX \"" + index.first + "\";").c_str());
+        if (rc != SQLITE_OK) {
+            return rc;  // 失败时 exec 已输出错误信息
+        }
+        dropped.push_back(index);
+    }
+    return SQLITE_OK;
+}
+
+int import_csv(Connection& conn, const std::string& filename, ImportStats* stats, size_t batch_size) {
+    auto start = std::chrono::steady_clock::now();
+    ImportStats result;
+    CsvReader reader;
+    if (!reader.open(filename)) {
+        std::cerr << "无法打开 CSV 文件: " << filename << std::endl;
+        return SQLITE_CANTOPEN;
+    }
+    if (batch_size == 0) {
+        batch_size = 100000;
+    }
+
+    // 记下原来的设置，导入后恢复
+    std::string synchronous = pragma_value(conn, "PRAGMA synchronous;");
+    std::string journal_mode = pragma_value(conn, "PRAGMA journal_mode;");
+    std::string cache_size = pragma_value(conn, "PRAGMA cache_size;");
+    std::vector<std::pair<std::string, std::string>> indexes;
+    int rc = drop_indexes(conn, indexes);
+    if (rc == SQLITE_OK) {
+        rc = conn.exec("PRAGMA synchronous = OFF;");
+    }
+    if (rc == SQLITE_OK) {
+        // 设置 journal_mode 的 PRAGMA 返回实际生效的模式；WAL 数据库被其他连接打开时切换不了
+        // （返回原模式或 SQLITE_BUSY），这时保留原模式导入，只是更慢
+        if (pragma_value(conn, "PRAGMA journal_mode = OFF;") != "off") {
+            std::cerr << "journal_mode 未能切换为 OFF，按原日志模式 " << journal_mode << " 导入" << std::endl;
+        }
+    }
+    if (rc == SQLITE_OK) {
+        rc = conn.exec("PRAGMA cache_size = -262144;");  // 256 MiB 页缓存，减少随机主键插入的换页
+    }
+
+    StatementScope insert(rc == SQLITE_OK ? conn.statement(R"(
+        INSERT OR IGNORE INTO person_info (id_card_number, name, gender, birth_date, address, phone)
+        VALUES (?, ?, ?, ?, ?, ?);
+    )") : nullptr);  // 已存在的身份证号与违反 NOT NULL 的行忽略，与 Data.py 的 INSERT OR IGNORE 相同
+    sqlite3_stmt* stmt = insert.get();
+    if (rc == SQLITE_OK) {
+        rc = stmt ? conn.exec("BEGIN;") : SQLITE_ERROR;
+    }
+
+    CsvField fields[kColumns];
+    size_t in_batch = 0;
+    bool first = true;
+    int count;
+    while (rc == SQLITE_OK && (count = reader.next(fields, kColumns)) >= 0) {
+        if (count == 1 && fields[0].size == 0) {
+            continue;  // 空行
+        }
+        if (first && count == kColumns && fields[0].size == 14 && std::memcmp(fields[0].data, "id_card_number", 14) == 0) {
+            first = false;
+            continue;  // Data.py 生成的表头行
+        }
+        first = false;
+        if (count != kColumns || !valid_id_card_number(fields[0].data, fields[0].size)) {
+            ++result.invalid;
+            continue;
+        }
+
+        for (int i = 0; i < kColumns; ++i) {
+            const CsvField& f = fields[i];
+            if (!f.quoted && f.size == 4 && std::memcmp(f.data, "NULL", 4) == 0) {
+                sqlite3_bind_null(stmt, i + 1);
+            }
+            else {
+                sqlite3_bind_text(stmt, i + 1, f.data, (int)f.size, SQLITE_STATIC);  // 字段在 step 之前一直有效
+            }
+        }
+        int step = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        if (step != SQLITE_DONE) {
+            std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+            rc = step;
+            break;
+        }
+        if (sqlite3_changes(conn.handle()) > 0) {
+            ++result.rows;
+        }
+        else {
+            ++result.ignored;
+        }
+
+        if (++in_batch == batch_size) {
+            rc = conn.exec("COMMIT;");
+            if (rc == SQLITE_OK) {
+                rc = conn.exec("BEGIN;");
+            }
+            in_batch = 0;
+        }
+    }
+    // journal_mode = OFF 时无法回滚，出错时也提交已插入的行（未能切换时同样提交，行为一致）
+    if (!sqlite3_get_autocommit(conn.handle())) {
+        int commit_rc = conn.exec("COMMIT;");
+        if (rc == SQLITE_OK) {
+            rc = commit_rc;
+        }
+    }
+
+    for (const auto& index : indexes) {
+        int index_rc = conn.exec(index.second.c_str());
+        if (rc == SQLITE_OK) {
+            rc = index_rc;
+        }
+    }
+    conn.exec(("PRAGMA journal_mode = " + journal_mode + ";").c_str());
+    conn.exec(("PRAGMA synchronous = " + synchronous + ";").c_str());
+    conn.exec(("PRAGMA cache_size = " + cache_size + ";").c_str());
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (stats) {
+        *stats = result;
+    }
+    return rc;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include "connection.h"
+
+// 导入结果统计
+struct ImportStats {
+    size_t rows = 0;        // 成功插入的行数
+    size_t invalid = 0;     // 列数不对或身份证号校验失败而跳过的行数
+    size_t ignored = 0;     // 身份证号重复或违反 NOT NULL 约束而忽略的行数
+    double seconds = 0;     // 导入耗时（含重建索引）
+};
+
+// 检查身份证号：18 位，前 17 位为数字，第 18 位为按权重计算的校验码（0~9 或 X）
+bool valid_id_card_number(const char* id, size_t size);
+
+// 把 CSV 文件批量导入 person_info（列顺序与表相同：身份证号、姓名、性别、出生日期、地址、电话）。
+// 文件按大块读入后原地解析，未加引号的字段直接绑定缓冲区中的字节，不做复制；支持双引号转义、可选的 UTF-8 BOM 与表头行，
+// 未加引号的 NULL 视为 SQL NULL（与 export_csv 的输出对应）。字节按原样写入，不做编码转换。
+// 导入期间临时设置 synchronous = OFF、journal_mode = OFF 并加大页缓存，每 batch_size 行提交一次；
+// person_info 上的二级索引先删除，导入完成后再重建（主键索引无法删除，仍随插入维护）。
+// 删除索引或设置 PRAGMA 失败时不导入，恢复原设置后返回错误码；WAL 数据库被其他连接打开时 journal_mode 无法改为 OFF，
+// 此时输出警告并保留原日志模式继续导入。
+// 导入期间崩溃可能损坏数据库，只应用于初始导入。返回 SQLite 结果码
+int import_csv(Connection& conn, const std::string& filename, ImportStats* stats = nullptr, size_t batch_size = 100000);
@@ -0,0 +1,156 @@
+#include "packed_person_db.h"
+#include <chrono>
+#include <iostream>
+
+sqlite3_int64 encode_id_card_number(const std::string& id_card_number) {
+    if (id_card_number.size() != 18) {
+        return -1;
+    }
+    sqlite3_int64 digits = 0;
+    for (size_t i = 0; i < 17; ++i) {
+        char c = id_card_number[i];
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+        digits = digits * 10 + (c - '0');
+    }
+    char check = id_card_number[17];
+    if (check >= '0' && check <= '9') {
+        return digits * 11 + (check - '0');
+    }
+    if (check == 'X' || check == 'x') {
+        return digits * 11 + 10;
+    }
+    return -1;
+}
+
+std::string decode_id_card_number(sqlite3_int64 key) {
+    sqlite3_int64 check = key % 11;
+    sqlite3_int64 digits = key / 11;
+    std::string id(18, '0');
+    id[17] = check == 10 ? 'X' : (char)('0' + check);
+    for (int i = 16; i >= 0; --i) {
+        id[i] = (char)('0' + digits % 10);
+        digits /= 10;
+    }
+    return id;
+}
+
+// 读取第 col 列的文本，NULL 时返回空字符串
+static std::string column_string(sqlite3_stmt* stmt, int col) {
+    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+    return text ? std::string(text, sqlite3_column_bytes(stmt, col)) : std::string();
+}
+
+// 执行一条不返回结果的缓存语句（绑定已完成），失败时输出错误信息
+static int step_done(Connection& conn, sqlite3_stmt* stmt) {
+    int rc = sqlite3_step(stmt);
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+        return rc;
+    }
+    return SQLITE_OK;
+}
+
+int create_packed_table(Connection& conn) {
+    const char* create_table_sql = R"(
+        CREATE TABLE IF NOT EXISTS person_info_packed (
+            id_card_key INTEGER PRIMARY KEY,  -- 压缩后的身份证号，即 rowid
+            name TEXT NOT NULL,               -- 姓名字段，不能为空
+            gender TEXT,                      -- 性别字段
+            birth_date TEXT,                  -- 出生日期字段
+            address TEXT,                     -- 地址字段
+            phone TEXT                        -- 电话字段
+        );
+    )";
+
+    return conn.exec(create_table_sql);  // 失败时 exec 已输出错误信息
+}
+
+int insert_packed_person_info(Connection& conn, const std::string& id_card_number, const std::string& name, const std::string& gender,
+    const std::string& birth_date, const std::string& address, const std::string& phone) {
+    sqlite3_int64 key = encode_id_card_number(id_card_number);
+    if (key < 0) {
+        std::cerr << "Invalid ID card number: " << id_card_number << std::endl;
+        return SQLITE_MISMATCH;
+    }
+
+    StatementScope scope(conn.statement(R"(
+        INSERT INTO person_info_packed (id_card_key, name, gender, birth_date, address, phone)
+        VALUES (?, ?, ?, ?, ?, ?);
+    )"));  // 插入数据的 SQL 语句
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+
+    sqlite3_bind_int64(stmt, 1, key);
+    sqlite3_bind_text(stmt, 2, name.c_str(), (int)name.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, gender.c_str(), (int)gender.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, birth_date.c_str(), (int)birth_date.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, address.c_str(), (int)address.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 6, phone.c_str(), (int)phone.size(), SQLITE_STATIC);
+
+    return step_done(conn, stmt);  // 执行插入操作
+}
+
+int insert_packed_person_batch(Connection& conn, const std::vector<Person>& people, size_t batch_size,
+    double* rows_per_second) {
+    auto start = std::chrono::steady_clock::now();
+    int rc = insert_in_batches(conn, people.size(), batch_size, [&](size_t i) {
+        const Person& p = people[i];
+        return insert_packed_person_info(conn, p.id_card_number, p.name, p.gender, p.birth_date, p.address, p.phone);
+    });
+
+    if (rc == SQLITE_OK && rows_per_second) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        *rows_per_second = seconds > 0 ? people.size() / seconds : 0;
+    }
+    return rc;
+}
+
+int find_packed_person(Connection& conn, const std::string& id_card_number, Person& person) {
+    sqlite3_int64 key = encode_id_card_number(id_card_number);
+    if (key < 0) {
+        return SQLITE_DONE;  // 格式不对的身份证号不可能在表中
+    }
+
+    StatementScope scope(conn.statement(
+        "SELECT name, gender, birth_date, address, phone FROM person_info_packed WHERE id_card_key = ?;"));
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+    sqlite3_bind_int64(stmt, 1, key);
+
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        person.id_card_number = decode_id_card_number(key);
+        person.name = column_string(stmt, 0);
+        person.gender = column_string(stmt, 1);
+        person.birth_date = column_string(stmt, 2);
+        person.address = column_string(stmt, 3);
+        person.phone = column_string(stmt, 4);
+    }
+    else if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+    }
+    return rc;
+}
+
+int delete_packed_person_info(Connection& conn, const std::string& id_card_number) {
+    sqlite3_int64 key = encode_id_card_number(id_card_number);
+    if (key < 0) {
+        std::cerr << "Invalid ID card number: " << id_card_number << std::endl;
+        return SQLITE_MISMATCH;
+    }
+
+    StatementScope scope(conn.statement("DELETE FROM person_info_packed WHERE id_card_key = ?;"));  // 删除 SQL 语句
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+    sqlite3_bind_int64(stmt, 1, key);
+
+    return step_done(conn, stmt);  // 执行删除操作
+}
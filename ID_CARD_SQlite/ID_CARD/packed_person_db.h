@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "connection.h"
+#include "person_db.h"
+
+// 整数主键方案：身份证号压缩成一个 64 位整数（前 17 位数字 × 11 + 校验码，X 记为 10），
+// 作为 person_info_packed 表的 INTEGER PRIMARY KEY，即 rowid 本身。
+// TEXT 主键方案的表需要 rowid 表与身份证号索引两棵 B 树，这里只有一棵，键也从 18 字节文本变成最多 8 字节的整数。
+// 压缩保持身份证号的字典序，按号段的范围查询仍可以用主键完成。对外接口仍使用 18 位字符串
+
+// 压缩身份证号；格式不对（不是 17 位数字加 0~9/X）时返回 -1
+sqlite3_int64 encode_id_card_number(const std::string& id_card_number);
+
+// 还原 18 位身份证号（校验码 x 统一还原为 X）
+std::string decode_id_card_number(sqlite3_int64 key);
+
+// 创建整数主键的 person_info_packed 表
+int create_packed_table(Connection& conn);
+
+// 插入个人信息；身份证号格式不对时输出错误并返回 SQLITE_MISMATCH
+int insert_packed_person_info(Connection& conn, const std::string& id_card_number, const std::string& name, const std::string& gender,
+    const std::string& birth_date, const std::string& address, const std::string& phone);
+
+// 按 insert_in_batches 的方式批量插入，rows_per_second 非空时写入本次插入的速度
+int insert_packed_person_batch(Connection& conn, const std::vector<Person>& people, size_t batch_size,
+    double* rows_per_second = nullptr);
+
+// 根据身份证号读取个人信息；找到时返回 SQLITE_ROW，不存在（或格式不对）时返回 SQLITE_DONE，出错时返回错误码
+int find_packed_person(Connection& conn, const std::string& id_card_number, Person& person);
+
+// 删除个人信息
+int delete_packed_person_info(Connection& conn, const std::string& id_card_number);
@@ -0,0 +1,107 @@
+#include "person_cache.h"
+
+PersonCache::PersonCache(size_t capacity, size_t shard_count) : hit_count(0), miss_count(0) {
+    if (shard_count == 0) {
+        shard_count = 1;
+    }
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards.emplace_back(new Shard());
+    }
+    shard_capacity = capacity / shard_count > 0 ? capacity / shard_count : 1;
+}
+
+bool PersonCache::get(const std::string& id_card_number, Person& person) {
+    Shard& shard = shardFor(id_card_number);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(id_card_number);
+    if (it == shard.index.end()) {
+        ++miss_count;
+        return false;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);  // 移到头部，迭代器仍然有效
+    person = *it->second;
+    ++hit_count;
+    return true;
+}
+
+uint64_t PersonCache::version(const std::string& id_card_number) {
+    Shard& shard = shardFor(id_card_number);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.version;
+}
+
+void PersonCache::put(const Person& person, uint64_t read_version) {
+    Shard& shard = shardFor(person.id_card_number);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.version != read_version) {
+        return;  // 读取期间有更新或删除，读到的可能是旧数据
+    }
+
+    auto it = shard.index.find(person.id_card_number);
+    if (it != shard.index.end()) {
+        *it->second = person;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    if (shard.lru.size() >= shard_capacity) {
+        shard.index.erase(shard.lru.back().id_card_number);  // 淘汰最久未使用的记录
+        shard.lru.pop_back();
+    }
+    shard.lru.push_front(person);
+    shard.index.emplace(person.id_card_number, shard.lru.begin());
+}
+
+void PersonCache::invalidate(const std::string& id_card_number) {
+    Shard& shard = shardFor(id_card_number);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    ++shard.version;
+    auto it = shard.index.find(id_card_number);
+    if (it != shard.index.end()) {
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+}
+
+void PersonCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        ++shard->version;
+        shard->lru.clear();
+        shard->index.clear();
+    }
+}
+
+size_t PersonCache::size() {
+    size_t total = 0;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->lru.size();
+    }
+    return total;
+}
+
+int find_person_cached(Connection& conn, PersonCache& cache, const std::string& id_card_number, Person& person) {
+    if (cache.get(id_card_number, person)) {
+        return SQLITE_ROW;
+    }
+    uint64_t read_version = cache.version(id_card_number);
+    int rc = find_person(conn, id_card_number, person);
+    if (rc == SQLITE_ROW) {
+        cache.put(person, read_version);
+    }
+    return rc;
+}
+
+int update_person_info_cached(Connection& conn, PersonCache& cache, const std::string& id_card_number,
+    const std::string& name, const std::string& phone) {
+    int rc = update_person_info(conn, id_card_number, name, phone);
+    cache.invalidate(id_card_number);  // 失败时也失效，下次从数据库重新读取
+    return rc;
+}
+
+int delete_person_info_cached(Connection& conn, PersonCache& cache, const std::string& id_card_number) {
+    int rc = delete_person_info(conn, id_card_number);
+    cache.invalidate(id_card_number);
+    return rc;
+}
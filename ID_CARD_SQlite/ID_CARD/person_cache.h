@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include "connection.h"
+#include "person_db.h"
+
+// 进程内的个人信息缓存：按身份证号哈希分成若干分片，每个分片各有一把锁和一条 LRU 链表，
+// 多个线程（如连接池的各个读线程）可以共用一个缓存。只缓存查到的记录，不缓存“不存在”
+class PersonCache {
+public:
+    // capacity 为总条数上限，平均分到 shard_count 个分片
+    explicit PersonCache(size_t capacity, size_t shard_count = 16);
+
+    PersonCache(const PersonCache&) = delete;
+    PersonCache& operator=(const PersonCache&) = delete;
+
+    // 命中时复制记录到 person 并移到 LRU 链表头部
+    bool get(const std::string& id_card_number, Person& person);
+
+    // 取得分片当前的版本号；从数据库读记录前调用，put 时传回
+    uint64_t version(const std::string& id_card_number);
+
+    // 放入记录；若读取数据库期间该分片发生过失效（版本号变化），放弃放入以免缓存旧数据
+    void put(const Person& person, uint64_t read_version);
+
+    // 使某条记录失效
+    void invalidate(const std::string& id_card_number);
+
+    void clear();
+
+    size_t size();
+    uint64_t hits() const { return hit_count.load(); }
+    uint64_t misses() const { return miss_count.load(); }
+    double hitRate() const {
+        uint64_t total = hits() + misses();
+        return total ? (double)hits() / total : 0;
+    }
+    void resetStats() {
+        hit_count = 0;
+        miss_count = 0;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::list<Person> lru;  // 头部为最近使用
+        std::unordered_map<std::string, std::list<Person>::iterator> index;
+        uint64_t version = 0;   // 每次失效加一
+    };
+
+    // 分片内的 unordered_map 用同一个 std::hash 选桶，MSVC 按低位掩码取桶。
+    // 若也用低位选分片，同一分片的键只会落进 1/分片数 的桶，所以先混合再取高 32 位
+    Shard& shardFor(const std::string& id_card_number) {
+        uint64_t h = std::hash<std::string>()(id_card_number);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return *shards[(size_t)(h >> 32) % shards.size()];
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t shard_capacity;
+    std::atomic<uint64_t> hit_count;
+    std::atomic<uint64_t> miss_count;
+};
+
+// 先查缓存，未命中时用 find_person 读数据库并放入缓存；返回值与 find_person 相同
+int find_person_cached(Connection& conn, PersonCache& cache, const std::string& id_card_number, Person& person);
+
+// 更新数据库后使缓存中的记录失效
+int update_person_info_cached(Connection& conn, PersonCache& cache, const std::string& id_card_number,
+    const std::string& name, const std::string& phone);
+
+// 删除数据库中的记录后使缓存中的记录失效
+int delete_person_info_cached(Connection& conn, PersonCache& cache, const std::string& id_card_number);
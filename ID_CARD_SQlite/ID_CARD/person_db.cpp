@@ -0,0 +1,387 @@
+#include "person_db.h"
+#include <iostream>
+#include <chrono>
+#include <codecvt>    // 用于 UTF-8 和宽字符（wchar_t）之间的转换
+#include <locale>
+#include <algorithm>
+
+// 转换器，用于将 UTF-8 字符串转换为宽字符（wchar_t）
+static std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
+
+// 读取第 col 列的文本，NULL 时返回空字符串
+static std::string column_string(sqlite3_stmt* stmt, int col) {
+    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+    return text ? std::string(text, sqlite3_column_bytes(stmt, col)) : std::string();
+}
+
+// 执行一条不返回结果的缓存语句（绑定已完成），失败时输出错误信息
+static int step_done(Connection& conn, sqlite3_stmt* stmt) {
+    int rc = sqlite3_step(stmt);
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+        return rc;
+    }
+    return SQLITE_OK;
+}
+
+// 执行一条缓存的不返回结果的语句（BEGIN/COMMIT/ROLLBACK 等）
+static int exec_cached(Connection& conn, const char* sql) {
+    StatementScope scope(conn.statement(sql));
+    return scope.get() ? step_done(conn, scope.get()) : SQLITE_ERROR;
+}
+
+int create_table(Connection& conn) {
+    // SQL 创建表格语句
+    const char* create_table_sql = R"(
+        CREATE TABLE IF NOT EXISTS person_info (
+            id_card_number TEXT PRIMARY KEY,  -- 身份证号码作为主键
+            name TEXT NOT NULL,               -- 姓名字段，不能为空
+            gender TEXT,                      -- 性别字段
+            birth_date TEXT,                  -- 出生日期字段
+            address TEXT,                     -- 地址字段
+            phone TEXT                        -- 电话字段
+        );
+    )";
+
+    return conn.exec(create_table_sql);  // 失败时 exec 已输出错误信息
+}
+
+int create_indexes(Connection& conn) {
+    const char* create_index_sql = R"(
+        CREATE INDEX IF NOT EXISTS idx_person_phone
+            ON person_info (phone, id_card_number, name, gender, birth_date, address);
+        CREATE INDEX IF NOT EXISTS idx_person_name
+            ON person_info (name, id_card_number, gender, birth_date, address, phone);
+        CREATE INDEX IF NOT EXISTS idx_person_birth_date
+            ON person_info (birth_date, id_card_number, name, gender, address, phone);
+    )";
+
+    return conn.exec(create_index_sql);  // 失败时 exec 已输出错误信息
+}
+
+// 执行已绑定参数的查询，把每行（列顺序与表相同）追加到 people，最多 limit 行（0 表示不限）
+static int collect_persons(Connection& conn, sqlite3_stmt* stmt, std::vector<Person>& people, size_t limit) {
+    int rc = SQLITE_DONE;
+    size_t count = 0;
+    while ((limit == 0 || count < limit) && (rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        Person person;
+        person.id_card_number = column_string(stmt, 0);
+        person.name = column_string(stmt, 1);
+        person.gender = column_string(stmt, 2);
+        person.birth_date = column_string(stmt, 3);
+        person.address = column_string(stmt, 4);
+        person.phone = column_string(stmt, 5);
+        people.push_back(std::move(person));
+        ++count;
+    }
+    if (limit != 0 && count == limit) {
+        return SQLITE_OK;
+    }
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+        return rc;
+    }
+    return SQLITE_OK;
+}
+
+int get_person_by_phone(Connection& conn, const std::string& phone, std::vector<Person>& people) {
+    StatementScope scope(conn.statement(
+        "SELECT id_card_number, name, gender, birth_date, address, phone FROM person_info WHERE phone = ?;"));
+    if (!scope.get()) {
+        return SQLITE_ERROR;
+    }
+    sqlite3_bind_text(scope.get(), 1, phone.c_str(), (int)phone.size(), SQLITE_STATIC);
+    return collect_persons(conn, scope.get(), people, 0);
+}
+
+int get_persons_by_name(Connection& conn, const std::string& name, std::vector<Person>& people) {
+    StatementScope scope(conn.statement(
+        "SELECT id_card_number, name, gender, birth_date, address, phone FROM person_info WHERE name = ?;"));
+    if (!scope.get()) {
+        return SQLITE_ERROR;
+    }
+    sqlite3_bind_text(scope.get(), 1, name.c_str(), (int)name.size(), SQLITE_STATIC);
+    return collect_persons(conn, scope.get(), people, 0);
+}
+
+int get_persons_born_between(Connection& conn, const std::string& from, const std::string& to,
+    std::vector<Person>& people, size_t limit) {
+    StatementScope scope(conn.statement(R"(
+        SELECT id_card_number, name, gender, birth_date, address, phone FROM person_info
+        WHERE birth_date BETWEEN ? AND ? ORDER BY birth_date;
+    )"));
+    if (!scope.get()) {
+        return SQLITE_ERROR;
+    }
+    sqlite3_bind_text(scope.get(), 1, from.c_str(), (int)from.size(), SQLITE_STATIC);
+    sqlite3_bind_text(scope.get(), 2, to.c_str(), (int)to.size(), SQLITE_STATIC);
+    return collect_persons(conn, scope.get(), people, limit);
+}
+
+int find_person(Connection& conn, const std::string& id_card_number, Person& person) {
+    StatementScope scope(conn.statement(
+        "SELECT name, gender, birth_date, address, phone FROM person_info WHERE id_card_number = ?;"));
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+
+    // 绑定查询条件（身份证号码）
+    sqlite3_bind_text(stmt, 1, id_card_number.c_str(), (int)id_card_number.size(), SQLITE_STATIC);
+
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        person.id_card_number = id_card_number;
+        person.name = column_string(stmt, 0);
+        person.gender = column_string(stmt, 1);
+        person.birth_date = column_string(stmt, 2);
+        person.address = column_string(stmt, 3);
+        person.phone = column_string(stmt, 4);
+    }
+    else if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+    }
+    return rc;
+}
+
+int find_persons(Connection& conn, const std::vector<std::string>& ids,
+    const std::function<void(size_t, const Person*)>& visit) {
+    // 走语句缓存：表已存在时只是一次空操作，不必每次重新解析
+    int rc = exec_cached(conn, "CREATE TEMP TABLE IF NOT EXISTS lookup_ids (pos INTEGER PRIMARY KEY, id_card_number TEXT);");
+    if (rc != SQLITE_OK) {
+        return rc;
+    }
+    bool own_transaction = sqlite3_get_autocommit(conn.handle()) != 0;
+    if (own_transaction && (rc = exec_cached(conn, "BEGIN;")) != SQLITE_OK) {
+        return rc;
+    }
+
+    // 写入本次查询的身份证号；临时表只对本连接可见，事务内的写入不落盘
+    rc = exec_cached(conn, "DELETE FROM temp.lookup_ids;");
+    {
+        StatementScope insert(conn.statement("INSERT INTO temp.lookup_ids (pos, id_card_number) VALUES (?, ?);"));
+        for (size_t i = 0; rc == SQLITE_OK && i < ids.size(); ++i) {
+            if (!insert.get()) {
+                rc = SQLITE_ERROR;
+                break;
+            }
+            sqlite3_bind_int64(insert.get(), 1, (sqlite3_int64)i);
+            sqlite3_bind_text(insert.get(), 2, ids[i].c_str(), (int)ids[i].size(), SQLITE_STATIC);
+            rc = step_done(conn, insert.get());
+            sqlite3_reset(insert.get());
+        }
+    }
+
+    // 外层按 pos（临时表的 rowid）顺序扫描，内层用主键索引查找，结果天然是输入顺序，不需要排序
+    if (rc == SQLITE_OK) {
+        StatementScope scope(conn.statement(R"(
+            SELECT l.pos, p.id_card_number IS NOT NULL, p.name, p.gender, p.birth_date, p.address, p.phone
+            FROM temp.lookup_ids AS l LEFT JOIN person_info AS p ON p.id_card_number = l.id_card_number
+            ORDER BY l.pos;
+        )"));
+        sqlite3_stmt* stmt = scope.get();
+        if (!stmt) {
+            rc = SQLITE_ERROR;
+        }
+        Person person;
+        int step = SQLITE_DONE;
+        while (stmt && (step = sqlite3_step(stmt)) == SQLITE_ROW) {
+            size_t pos = (size_t)sqlite3_column_int64(stmt, 0);
+            if (sqlite3_column_int(stmt, 1)) {
+                person.id_card_number = ids[pos];
+                person.name = column_string(stmt, 2);
+                person.gender = column_string(stmt, 3);
+                person.birth_date = column_string(stmt, 4);
+                person.address = column_string(stmt, 5);
+                person.phone = column_string(stmt, 6);
+                visit(pos, &person);
+            }
+            else {
+                visit(pos, nullptr);
+            }
+        }
+        if (stmt && step != SQLITE_DONE) {
+            std::cerr << "Execution failed: " << sqlite3_errmsg(conn.handle()) << std::endl;
+            rc = step;
+        }
+    }
+
+    if (own_transaction) {
+        int end_rc = exec_cached(conn, rc == SQLITE_OK ? "COMMIT;" : "ROLLBACK;");
+        if (rc == SQLITE_OK) {
+            rc = end_rc;
+        }
+    }
+    return rc;
+}
+
+int find_persons(Connection& conn, const std::vector<std::string>& ids, std::vector<PersonLookup>& results) {
+    results.assign(ids.size(), PersonLookup());
+    return find_persons(conn, ids, [&](size_t pos, const Person* person) {
+        PersonLookup& result = results[pos];
+        result.found = person != nullptr;
+        if (person) {
+            result.person = *person;
+        }
+        else {
+            result.person.id_card_number = ids[pos];
+        }
+    });
+}
+
+int get_person_info(Connection& conn, const std::string& id_card_number) {
+    Person person;
+    int rc = find_person(conn, id_card_number, person);
+    if (rc == SQLITE_ROW) {
+        // 将查询结果转换为宽字符并打印
+        std::cout << "Name: " << converter.from_bytes(person.name).c_str() << std::endl;
+        std::cout << "Gender: " << converter.from_bytes(person.gender).c_str() << std::endl;
+        std::cout << "Birth Date: " << converter.from_bytes(person.birth_date).c_str() << std::endl;
+        std::cout << "Address: " << converter.from_bytes(person.address).c_str() << std::endl;
+        std::cout << "Phone: " << converter.from_bytes(person.phone).c_str() << std::endl;
+    }
+    else {
+        std::cerr << "No record found for ID card number: " << id_card_number << std::endl;
+    }
+    return rc;
+}
+
+int insert_person_info(Connection& conn, const std::string& id_card_number, const std::string& name, const std::string& gender,
+    const std::string& birth_date, const std::string& address, const std::string& phone) {
+    StatementScope scope(conn.statement(R"(
+        INSERT INTO person_info (id_card_number, name, gender, birth_date, address, phone)
+        VALUES (?, ?, ?, ?, ?, ?);
+    )"));  // 插入数据的 SQL 语句
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+
+    // 绑定插入数据
+    sqlite3_bind_text(stmt, 1, id_card_number.c_str(), (int)id_card_number.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, name.c_str(), (int)name.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, gender.c_str(), (int)gender.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 4, birth_date.c_str(), (int)birth_date.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 5, address.c_str(), (int)address.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 6, phone.c_str(), (int)phone.size(), SQLITE_STATIC);
+
+    return step_done(conn, stmt);  // 执行插入操作
+}
+
+int insert_in_batches(Connection& conn, size_t count, size_t batch_size, const std::function<int(size_t)>& insert_row,
+    size_t* committed_rows) {
+    bool own_transaction = sqlite3_get_autocommit(conn.handle()) != 0;  // 调用方没有开启事务
+    if (batch_size == 0) {
+        batch_size = count;
+    }
+    if (committed_rows) {
+        *committed_rows = 0;
+    }
+
+    // 结束失败的批次：SQLITE_FULL、SQLITE_IOERR、SQLITE_NOMEM 等错误已回滚整个事务，
+    // COMMIT 返回 SQLITE_BUSY 时事务仍然开着，只在事务还在时回滚，保证返回时连接处于自动提交状态
+    auto abandon_batch = [&](int rc) {
+        if (own_transaction && !sqlite3_get_autocommit(conn.handle())) {
+            exec_cached(conn, "ROLLBACK;");
+        }
+        return rc;
+    };
+
+    for (size_t begin = 0; begin < count; begin += batch_size) {
+        size_t end = std::min(count, begin + batch_size);
+        if (own_transaction) {
+            int rc = exec_cached(conn, "BEGIN IMMEDIATE;");
+            if (rc != SQLITE_OK) {
+                return rc;  // 如 SQLITE_BUSY，调用方可从 committed_rows 处重试
+            }
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            int rc = insert_row(i);
+            if (rc != SQLITE_OK) {
+                return abandon_batch(rc);
+            }
+        }
+
+        if (own_transaction) {
+            int rc = exec_cached(conn, "COMMIT;");
+            if (rc != SQLITE_OK) {
+                return abandon_batch(rc);
+            }
+            if (committed_rows) {
+                *committed_rows = end;
+            }
+        }
+    }
+    return SQLITE_OK;
+}
+
+int insert_person_batch(Connection& conn, const std::vector<Person>& people, size_t batch_size,
+    double* rows_per_second) {
+    auto start = std::chrono::steady_clock::now();
+    int rc = insert_in_batches(conn, people.size(), batch_size, [&](size_t i) {
+        const Person& p = people[i];
+        return insert_person_info(conn, p.id_card_number, p.name, p.gender, p.birth_date, p.address, p.phone);
+    });
+
+    if (rc == SQLITE_OK && rows_per_second) {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        *rows_per_second = seconds > 0 ? people.size() / seconds : 0;
+    }
+    return rc;
+}
+
+int query_person_info(Connection& conn, const std::string& id_card_number) {
+    StatementScope scope(conn.statement("SELECT * FROM person_info WHERE id_card_number = ?;"));  // 查询 SQL 语句
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+
+    sqlite3_bind_text(stmt, 1, id_card_number.c_str(), (int)id_card_number.size(), SQLITE_STATIC);  // 绑定查询条件
+
+    // 执行查询
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        // 如果查询成功，输出查询结果
+        std::cout << "ID Card Number: " << sqlite3_column_text(stmt, 0) << std::endl;
+        std::cout << "Name: " << sqlite3_column_text(stmt, 1) << std::endl;
+        std::cout << "Gender: " << sqlite3_column_text(stmt, 2) << std::endl;
+        std::cout << "Birth Date: " << sqlite3_column_text(stmt, 3) << std::endl;
+        std::cout << "Address: " << sqlite3_column_text(stmt, 4) << std::endl;
+        std::cout << "Phone: " << sqlite3_column_text(stmt, 5) << std::endl;
+    }
+    else {
+        std::cout << "No record found with this ID card number!" << std::endl;
+    }
+    return SQLITE_OK;  // 查询成功
+}
+
+int update_person_info(Connection& conn, const std::string& id_card_number, const std::string& name, const std::string& phone) {
+    StatementScope scope(conn.statement(R"(
+        UPDATE person_info SET name = ?, phone = ? WHERE id_card_number = ?;
+    )"));  // 更新 SQL 语句
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+
+    // 绑定更新数据
+    sqlite3_bind_text(stmt, 1, name.c_str(), (int)name.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, phone.c_str(), (int)phone.size(), SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, id_card_number.c_str(), (int)id_card_number.size(), SQLITE_STATIC);
+
+    return step_done(conn, stmt);  // 执行更新操作
+}
+
+int delete_person_info(Connection& conn, const std::string& id_card_number) {
+    StatementScope scope(conn.statement("DELETE FROM person_info WHERE id_card_number = ?;"));  // 删除 SQL 语句
+    sqlite3_stmt* stmt = scope.get();
+    if (!stmt) {
+        return SQLITE_ERROR;
+    }
+
+    sqlite3_bind_text(stmt, 1, id_card_number.c_str(), (int)id_card_number.size(), SQLITE_STATIC);  // 绑定删除条件
+
+    return step_done(conn, stmt);  // 执行删除操作
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "connection.h"
+
+// 一条个人信息记录
+struct Person {
+    std::string id_card_number;
+    std::string name;
+    std::string gender;
+    std::string birth_date;
+    std::string address;
+    std::string phone;
+};
+
+// 创建数据库表格，用于存储个人信息
+int create_table(Connection& conn);
+
+// 根据身份证号码读取个人信息到 person；找到时返回 SQLITE_ROW，不存在时返回 SQLITE_DONE，出错时返回错误码
+int find_person(Connection& conn, const std::string& id_card_number, Person& person);
+
+// 在 phone、name、birth_date 上创建覆盖索引（索引包含整行的所有列，按这三列查询时不需要再回表）。
+// 每个索引约与表本身一样大，插入时也要同步维护；批量导入时 import_csv 会先删除再重建这些索引
+int create_indexes(Connection& conn);
+
+// 按电话号码查询，结果追加到 people（电话不唯一，可能有多条）；返回 SQLite 结果码
+int get_person_by_phone(Connection& conn, const std::string& phone, std::vector<Person>& people);
+
+// 按姓名查询，结果追加到 people；返回 SQLite 结果码
+int get_persons_by_name(Connection& conn, const std::string& name, std::vector<Person>& people);
+
+// 查询出生日期在 [from, to] 内的人（日期格式 YYYY-MM-DD），按出生日期排序追加到 people；
+// limit 为最多返回的条数，0 表示不限；返回 SQLite 结果码
+int get_persons_born_between(Connection& conn, const std::string& from, const std::string& to,
+    std::vector<Person>& people, size_t limit = 0);
+
+// 批量查询的一条结果
+struct PersonLookup {
+    bool found;
+    Person person;  // found 为 false 时只有 id_card_number 有效
+};
+
+// 批量查询：把 ids 连同下标写入临时表 temp.lookup_ids，再与 person_info 做一次 LEFT JOIN，
+// 按输入顺序对每个身份证号调用 visit(下标, 记录)，不存在时记录为 nullptr。ids 中可以有重复。返回 SQLite 结果码
+int find_persons(Connection& conn, const std::vector<std::string>& ids,
+    const std::function<void(size_t, const Person*)>& visit);
+
+// 批量查询，结果按输入顺序放进 results
+int find_persons(Connection& conn, const std::vector<std::string>& ids, std::vector<PersonLookup>& results);
+
+// 根据身份证号码查询个人信息并打印
+int get_person_info(Connection& conn, const std::string& id_card_number);
+
+// 插入个人信息到数据库
+int insert_person_info(Connection& conn, const std::string& id_card_number, const std::string& name, const std::string& gender,
+    const std::string& birth_date, const std::string& address, const std::string& phone);
+
+// 按 batch_size 行一个事务依次调用 insert_row(0) ~ insert_row(count - 1)（0 表示全部放进一个事务）。
+// 调用时已处于事务中则不再另开事务。insert_row、BEGIN 或 COMMIT 失败时回滚当前批次并返回该错误码，
+// 返回时连接不会留在事务中；之前已提交的批次保留，committed_rows 非空时写入已提交的行数（前 committed_rows 行），
+// 遇到 SQLITE_BUSY 可从该行起重试。调用方自己开启事务时不提交，committed_rows 为 0
+int insert_in_batches(Connection& conn, size_t count, size_t batch_size, const std::function<int(size_t)>& insert_row,
+    size_t* committed_rows = nullptr);
+
+// 批量插入：按 insert_in_batches 的方式每 batch_size 行提交一次，复用同一条预编译的插入语句。
+// 失败时之前已提交的批次保留，整体重试会遇到主键冲突。rows_per_second 非空时写入本次插入的速度
+int insert_person_batch(Connection& conn, const std::vector<Person>& people, size_t batch_size,
+    double* rows_per_second = nullptr);
+
+// 查询个人信息并打印全部字段（与 get_person_info 函数相似）
+int query_person_info(Connection& conn, const std::string& id_card_number);
+
+// 更新个人信息
+int update_person_info(Connection& conn, const std::string& id_card_number, const std::string& name, const std::string& phone);
+
+// 删除个人信息
+int delete_person_info(Connection& conn, const std::string& id_card_number);